@@ -2,13 +2,21 @@
 #include "HX_ESPNOW_RC_Slave.h"
 #include "rx_config.h"
 #include "hx_mavlink_rc_encoder.h"
+#include "hx_mavlink_radio_status.h"
 #include "HX_ESPNOW_RC_SerialBuffer.h"
+#include "HX_ESPNOW_RC_MavlinkStreamFilter.h"
 
 #include <ArduinoOTA.h>
 
 HXRCSlave hxrcSlave;
 HXRCSerialBuffer<512> hxrcTelemetrySerial( &hxrcSlave );
 HXMavlinkRCEncoder hxMavlinkRCEncoder;
+HXMavlinkRadioStatus hxMavlinkRadioStatus;
+
+#if USE_MAVLINK_STREAM_FILTER
+HXRCMavlinkStreamFilter mavlinkStreamFilter;
+const HXRCMavlinkFilterRule mavlinkStreamFilterRules[] = { MAVLINK_STREAM_FILTER_RULES };
+#endif
 
 unsigned long lastStats = millis();
 
@@ -27,14 +35,49 @@ void processIncomingTelemetry()
 //=====================================================================
 void fillOutgoingTelemetry()
 {
+#if USE_MAVLINK_STREAM_FILTER
+  //pass frames only if whole frame fits into buffer
+  while ( hxrcTelemetrySerial.getAvailableForWrite() >= HXRC_MAVLINK_FRAME_SIZE_MAX )
+  {
+    if ( mavlinkStreamFilter.nextFrame() )
+    {
+      const uint8_t* frame = mavlinkStreamFilter.getFrame();
+      uint16_t len = mavlinkStreamFilter.getFrameLength();
+      for ( uint16_t i = 0; i < len; i++ ) hxrcTelemetrySerial.write( frame[i] );
+      continue;
+    }
+
+    uint8_t buffer[64];
+    int n = Serial.available();
+    if ( n <= 0 ) break;
+    if ( n > (int)sizeof( buffer ) ) n = sizeof( buffer );
+    if ( n > mavlinkStreamFilter.getAvailableForWrite() ) n = mavlinkStreamFilter.getAvailableForWrite();
+    n = Serial.readBytes( buffer, n );
+    mavlinkStreamFilter.write( buffer, n );
+  }
+#else
   while ( (Serial.available() > 0) && (hxrcTelemetrySerial.getAvailableForWrite() > 0) )
   {
     uint8_t c = Serial.read();
     hxrcTelemetrySerial.write(c);
   }
+#endif
 }
 
 
+#if USE_MAVLINK_RADIO_STATUS
+//=====================================================================
+//=====================================================================
+void updateRadioStatus( HardwareSerial& serial )
+{
+  hxMavlinkRadioStatus.setRSSIDbm( hxrcSlave.getTransmitterStats().getRSSIDbm(), hxrcSlave.getReceiverStats().getRemoteRSSIDbm() );
+  hxMavlinkRadioStatus.setNoiseFloorDbm( hxrcSlave.getTransmitterStats().getNoiseFloor(), hxrcSlave.getReceiverStats().getRemoteNoiseFloor() );
+  hxMavlinkRadioStatus.setTxBufferFill( hxrcSlave.getOutgoingTelemetryBufferFill() );
+  hxMavlinkRadioStatus.setRxErrors( hxrcSlave.getReceiverStats().packetsLost );
+  hxMavlinkRadioStatus.loop( serial );
+}
+#endif
+
 //=====================================================================
 //=====================================================================
 void setup()
@@ -48,12 +91,25 @@ void setup()
   
   hxMavlinkRCEncoder.init( MAVLINK_RC_PACKET_RATE_MS, USE_MAVLINK_V1 );
 
-  hxrcSlave.init(
-      HXRCConfig(
+#if USE_MAVLINK_RADIO_STATUS
+  hxMavlinkRadioStatus.init( MAVLINK_RADIO_STATUS_PERIOD_MS, USE_MAVLINK_V1 );
+#endif
+
+#if USE_MAVLINK_STREAM_FILTER
+  mavlinkStreamFilter.init( mavlinkStreamFilterRules, sizeof( mavlinkStreamFilterRules ) / sizeof( mavlinkStreamFilterRules[0] ) );
+#endif
+
+  HXRCConfig config(
           USE_WIFI_CHANNEL,
           USE_KEY,
           false,
-          -1, false));
+          -1, false);
+  config.mavlinkFrameQueue = USE_MAVLINK_FRAME_QUEUE;
+  //frames are validated by stream filter, queue does not parse them again
+  config.mavlinkFrameQueueValidatedInput = USE_MAVLINK_STREAM_FILTER;
+  config.failsafePeriodMs = USE_FAILSAFE_PERIOD_MS;
+  config.telemetrySizeMax = USE_TELEMETRY_SIZE_MAX;
+  hxrcSlave.init( config );
 
   hxrcSlave.setA1(42);
 
@@ -84,6 +140,10 @@ void updateOutput()
   }
 
   hxMavlinkRCEncoder.loop( Serial );
+
+#if USE_MAVLINK_RADIO_STATUS
+  updateRadioStatus( Serial );
+#endif
 }
 
 //=====================================================================
@@ -106,6 +166,9 @@ void loop()
     lastStats = millis();
     hxrcSlave.getTransmitterStats().printStats();
     hxrcSlave.getReceiverStats().printStats();
+#if USE_MAVLINK_STREAM_FILTER
+    mavlinkStreamFilter.printStats();
+#endif
   }
 */
 
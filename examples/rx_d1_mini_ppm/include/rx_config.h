@@ -35,3 +35,9 @@ GPIO13 - Telemetry RX
 #define USE_WIFI_CHANNEL 3
 #define USE_KEY 0 
 
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
+
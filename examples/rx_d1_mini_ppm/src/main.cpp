@@ -49,12 +49,14 @@ void setup()
 
   hxPPMEncoder.init( PPM_CHANNELS_COUNT, PPM_PIN );  
 
-  hxrcSlave.init(
-      HXRCConfig(
+  HXRCConfig config(
           USE_WIFI_CHANNEL,
           USE_KEY,
           false,
-          -1, false));  //LED_BUILTIN, true
+          -1, false);  //LED_BUILTIN, true
+  config.failsafePeriodMs = USE_FAILSAFE_PERIOD_MS;
+  config.telemetrySizeMax = USE_TELEMETRY_SIZE_MAX;
+  hxrcSlave.init( config );
 
   hxrcSlave.setA1(42);
 
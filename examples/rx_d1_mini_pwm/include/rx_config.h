@@ -59,6 +59,12 @@ Failsafe:
 #define USE_WIFI_CHANNEL 3
 #define USE_KEY 0 
 
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
+
 //Receiver configuration 1: AETR brushless plane
 //==========================================================================================
 //4 servo outputs: D5,D6,D7,D8 for RC channels 1,2,3,4
@@ -371,12 +371,14 @@ void setup()
   Serial.begin(115200);
   Serial.println("Start");
 
-  hxrcSlave.init(
-      HXRCConfig(
+  HXRCConfig config(
           USE_WIFI_CHANNEL,
           USE_KEY,
           false,
-          LED_BUILTIN, true));
+          LED_BUILTIN, true);
+  config.failsafePeriodMs = USE_FAILSAFE_PERIOD_MS;
+  config.telemetrySizeMax = USE_TELEMETRY_SIZE_MAX;
+  hxrcSlave.init( config );
 
   //REVIEW: receiver does not work if AP is not initialized?
   WiFi.softAP("hxrcr", NULL, USE_WIFI_CHANNEL);
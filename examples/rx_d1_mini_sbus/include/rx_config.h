@@ -24,10 +24,26 @@ GPIO13 - RX
 //inverted SBUS = true ===> normal UART
 #define SBUS_INVERTED  false
 
+//SBUS output speed: SBUS_BAUDRATE (100000) or SBUS_FAST_BAUDRATE (200000)
+#define SBUS_OUTPUT_BAUDRATE SBUS_BAUDRATE
+//SBUS frame period if there are no new packets: SBUS_PERIOD_MS (14) or SBUS_FAST_PERIOD_MS (7)
+#define SBUS_OUTPUT_PERIOD_MS SBUS_PERIOD_MS
+
 //#define TELEMETRY_BAUDRATE 115200
 #define TELEMETRY_BAUDRATE 9600
 
+//Telemetry stream is MAVLink: periodically send RADIO_STATUS to flight controller, like SiK radio does.
+//txbuf field reports free space in telemetry buffer, so flight controller adapts stream rate to link capacity.
+//Message is inserted between MAVLink frames coming from transmitter.
+#define USE_MAVLINK_RADIO_STATUS false
+
 //=============================================================================
 //Receiver binding
 #define USE_WIFI_CHANNEL 3
 #define USE_KEY 0 
+
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
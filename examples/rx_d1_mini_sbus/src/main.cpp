@@ -3,12 +3,15 @@
 #include "rx_config.h"
 #include "hx_sbus_encoder.h"
 #include "HX_ESPNOW_RC_SerialBuffer.h"
+#include "hx_mavlink_radio_status.h"
 
 #include <ArduinoOTA.h>
 
 HXRCSlave hxrcSlave;
 HXRCSerialBuffer<512> hxrcTelemetrySerial( &hxrcSlave );
+HXMavlinkRadioStatus hxMavlinkRadioStatus;
 HXSBUSEncoder hxSBUSEncoder;
+uint32_t lastChannelsCounter = 0;
 
 unsigned long lastStats = millis();
 
@@ -20,6 +23,9 @@ void processIncomingTelemetry()
   {
     uint8_t c = hxrcTelemetrySerial.read();
     Serial.write( c );
+#if USE_MAVLINK_RADIO_STATUS
+    hxMavlinkRadioStatus.onUplinkByte( c );
+#endif
   }
 }
 
@@ -35,6 +41,19 @@ void fillOutgoingTelemetry()
 }
 
 
+#if USE_MAVLINK_RADIO_STATUS
+//=====================================================================
+//=====================================================================
+void updateRadioStatus( HardwareSerial& serial )
+{
+  hxMavlinkRadioStatus.setRSSIDbm( hxrcSlave.getTransmitterStats().getRSSIDbm(), hxrcSlave.getReceiverStats().getRemoteRSSIDbm() );
+  hxMavlinkRadioStatus.setNoiseFloorDbm( hxrcSlave.getTransmitterStats().getNoiseFloor(), hxrcSlave.getReceiverStats().getRemoteNoiseFloor() );
+  hxMavlinkRadioStatus.setTxBufferFill( hxrcSlave.getOutgoingTelemetryBufferFill() );
+  hxMavlinkRadioStatus.setRxErrors( hxrcSlave.getReceiverStats().packetsLost );
+  hxMavlinkRadioStatus.loop( serial );
+}
+#endif
+
 //=====================================================================
 //=====================================================================
 void setup()
@@ -46,14 +65,20 @@ void setup()
 
   Serial.swap(); //GPIO15 D8 (TX) and GPIO13 D7 (RX)
   
-  hxSBUSEncoder.init( Serial1, 2, SBUS_INVERTED );
+  hxSBUSEncoder.init( Serial1, 2, SBUS_INVERTED, SBUS_OUTPUT_BAUDRATE, SBUS_OUTPUT_PERIOD_MS );
 
-  hxrcSlave.init(
-      HXRCConfig(
+  HXRCConfig config(
           USE_WIFI_CHANNEL,
           USE_KEY,
           false,
-          -1, false));
+          -1, false);
+  config.failsafePeriodMs = USE_FAILSAFE_PERIOD_MS;
+  config.telemetrySizeMax = USE_TELEMETRY_SIZE_MAX;
+  hxrcSlave.init( config );
+
+#if USE_MAVLINK_RADIO_STATUS
+  hxMavlinkRadioStatus.init();
+#endif
 
   //REVIEW: receiver does not work if AP is not initialized?
   WiFi.softAP("hxrcrsbus", NULL, USE_WIFI_CHANNEL);
@@ -68,17 +93,31 @@ void updateSBUSOutput()
   //set failsafe flag
   bool failsafe = hxrcSlave.getReceiverStats().isFailsafe();
   hxSBUSEncoder.setFailsafe( failsafe);
+  //few frames missed: channels keep last values
+  hxSBUSEncoder.setFrameLost( hxrcSlave.getReceiverStats().isSignalHold() );
   
   //inject RSSI into channel 16
   hxSBUSEncoder.setChannelValue( HXRC_CHANNELS_COUNT-1, 1000 + ((uint16_t)hxrcSlave.getReceiverStats().getRSSI())*10 );
 
   if ( !failsafe ) //keep last channel values on failsafe
   {
-    HXRCChannels channels = hxrcSlave.getChannels();
+    uint32_t channelsCounter;
+    unsigned long channelsTimeUs;
+    HXRCChannels channels = hxrcSlave.getChannels( &channelsCounter, &channelsTimeUs );
     for ( int i = 0; i < HXRC_CHANNELS_COUNT-1; i++)
     {
       hxSBUSEncoder.setChannelValue( i, channels.getChannelValue(i) );
     }
+    for ( int i = HXRC_CHANNELS_COUNT; i < HXRC_CHANNELS_COUNT + HXRC_DIGITAL_CHANNELS_COUNT; i++)
+    {
+      hxSBUSEncoder.setChannelValue( i, channels.getChannelValue(i) );
+    }
+    if ( channelsCounter != lastChannelsCounter )
+    {
+      //send new values immediately
+      lastChannelsCounter = channelsCounter;
+      hxSBUSEncoder.onChannelsReceived( channelsTimeUs );
+    }
   }
 
   hxSBUSEncoder.loop( Serial1 );
@@ -90,6 +129,10 @@ void loop()
 {
   hxrcTelemetrySerial.flushIn();
   processIncomingTelemetry();
+
+#if USE_MAVLINK_RADIO_STATUS
+  updateRadioStatus( Serial );
+#endif
   
   fillOutgoingTelemetry();
   hxrcTelemetrySerial.flushOut();
@@ -108,6 +151,7 @@ void loop()
     lastStats = millis();
     hxrcSlave.getTransmitterStats().printStats();
     hxrcSlave.getReceiverStats().printStats();
+    hxSBUSEncoder.printStats();
   }
 */
 
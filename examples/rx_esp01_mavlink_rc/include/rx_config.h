@@ -17,6 +17,26 @@ https://randomnerdtutorials.com/esp8266-pinout-reference-gpios/
 //Use Mavlink v1 ( 8 RC Channels ) or Mavlink v2 (15 RC Channels)
 #define USE_MAVLINK_V1 false
 
+//Send whole Mavlink frames to transmitter. On overflow, drop whole frames instead of bytes.
+//Repeated stream messages (f.e. ATTITUDE) waiting in queue are replaced by the latest one.
+#define USE_MAVLINK_FRAME_QUEUE true
+
+//Drop or decimate MAVLink messages from flight controller before sending them to transmitter.
+//HEARTBEAT and COMMAND_ACK are always passed. Messages without rule are passed.
+#define USE_MAVLINK_STREAM_FILTER true
+
+//{ msgId, min interval ms }, HXRC_MAVLINK_FILTER_DROP - drop message
+#define MAVLINK_STREAM_FILTER_RULES \
+  { 36, HXRC_MAVLINK_FILTER_DROP }, /*SERVO_OUTPUT_RAW*/ \
+  { 35, 1000 },                     /*RC_CHANNELS_RAW*/ \
+  { 65, 1000 },                     /*RC_CHANNELS*/ \
+  { 30, 100 },                      /*ATTITUDE*/ \
+  { 74, 200 },                      /*VFR_HUD*/
+
+//Periodically send RADIO_STATUS to flight controller, like SiK radio does.
+//txbuf field reports free space in telemetry buffer, so flight controller adapts stream rate to link capacity.
+#define USE_MAVLINK_RADIO_STATUS true
+
 //Telemetry/mavlink port speed
 #define TELEMETRY_BAUDRATE 115200
 
@@ -41,3 +61,9 @@ https://randomnerdtutorials.com/esp8266-pinout-reference-gpios/
 //Receiver binding
 #define USE_WIFI_CHANNEL 3
 #define USE_KEY 0 
+
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
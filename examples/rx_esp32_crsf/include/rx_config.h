@@ -0,0 +1,31 @@
+#pragma once
+
+/*
+Pinout:
+https://randomnerdtutorials.com/esp32-pinout-reference-gpios/
+*/
+
+//CRSF connection to flight controller (UART1): RC frames and link statistics to FC, telemetry from FC
+#define CRSF_RX_PIN 21
+#define CRSF_TX_PIN 22
+
+//CRSF_BAUDRATE = 420000
+#define CRSF_OUTPUT_BAUDRATE CRSF_BAUDRATE
+
+//=============================================================================
+//Receiver binding
+#define USE_WIFI_CHANNEL 3
+#define USE_KEY 0 
+
+#define USE_LR_MODE true
+
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
+
+//if there is not transmitter connection after powerup to the specified time,
+//receiver will switch from LR to nomal mode to show AP and allow OTA updates
+//set to 0 to disable
+#define NORMAL_MODE_DELAY_MS 60*1000
@@ -0,0 +1,168 @@
+#include <Arduino.h>
+#include "HX_ESPNOW_RC_Slave.h"
+#include "rx_config.h"
+#include "hx_crsf_encoder.h"
+
+#include <esp_task_wdt.h>
+
+#include <ArduinoOTA.h>
+
+#define WDT_TIMEOUT_SECONDS 3  
+
+HXRCSlave hxrcSlave;
+HXCRSFEncoder hxCRSFEncoder;
+uint32_t lastChannelsCounter = 0;
+
+unsigned long lastStats = millis();
+
+//0 - got connection once
+//1 - switched to normal mode
+//2 - waiting for connection
+//other - millis() at startup
+uint8_t state = 2;
+unsigned long startTime = millis();
+
+//=====================================================================
+//=====================================================================
+void processIncomingTelemetry()
+{
+  //CRSF output does not carry telemetry from transmitter to FC
+  uint8_t buffer[64];
+  while ( hxrcSlave.getIncomingTelemetry( sizeof(buffer), buffer ) > 0 );
+}
+
+//=====================================================================
+//=====================================================================
+void fillOutgoingTelemetry()
+{
+  //pass CRSF telemetry frames from FC to transmitter as is
+  uint8_t frame[CRSF_FRAME_SIZE_MAX];
+  uint8_t len;
+  while ( ( len = hxCRSFEncoder.getTelemetryFrame( frame ) ) > 0 )
+  {
+    hxrcSlave.sendOutgoingTelemetry( frame, len );
+  }
+}
+
+//=====================================================================
+//=====================================================================
+void onOTAprogress( uint a, uint b )  
+{
+  esp_task_wdt_reset();
+}
+
+//=====================================================================
+//=====================================================================
+void setup()
+{
+  esp_task_wdt_init(WDT_TIMEOUT_SECONDS, true); //enable panic so ESP32 restarts
+  esp_task_wdt_add(NULL); //add current thread to WDT watch
+
+  Serial.begin(115200);
+
+  hxCRSFEncoder.init( Serial1, CRSF_RX_PIN, CRSF_TX_PIN, CRSF_OUTPUT_BAUDRATE );
+
+  HXRCConfig config(
+          USE_WIFI_CHANNEL,
+          USE_KEY,
+          USE_LR_MODE,
+          -1, false);
+  config.failsafePeriodMs = USE_FAILSAFE_PERIOD_MS;
+  config.telemetrySizeMax = USE_TELEMETRY_SIZE_MAX;
+  hxrcSlave.init( config );
+
+  //REVIEW: receiver does not work if AP is not initialized?
+  WiFi.softAP("hxrcrcrsf", NULL, USE_WIFI_CHANNEL);
+
+  ArduinoOTA.onProgress(&onOTAprogress);
+  ArduinoOTA.begin();  
+}
+
+//=====================================================================
+//=====================================================================
+void updateCRSFOutput()
+{
+  HXRCReceiverStats& receiverStats = hxrcSlave.getReceiverStats();
+  HXRCTransmitterStats& transmitterStats = hxrcSlave.getTransmitterStats();
+
+  //RC frames are not sent on failsafe, FC detects signal loss
+  bool failsafe = receiverStats.isFailsafe();
+  hxCRSFEncoder.setFailsafe( failsafe );
+
+  hxCRSFEncoder.setLinkStatistics( 
+    transmitterStats.getRSSIDbm(), receiverStats.getRSSI(), transmitterStats.getSNR(),
+    receiverStats.getRemoteRSSIDbm(), transmitterStats.getRSSI() );
+
+  if ( !failsafe ) 
+  {
+    uint32_t channelsCounter;
+    HXRCChannels channels = hxrcSlave.getChannels( &channelsCounter, NULL );
+    for ( int i = 0; i < HXRC_CHANNELS_COUNT; i++)
+    {
+      hxCRSFEncoder.setChannelValue( i, channels.getChannelValue(i) );
+    }
+    if ( channelsCounter != lastChannelsCounter )
+    {
+      //send new values immediately
+      lastChannelsCounter = channelsCounter;
+      hxCRSFEncoder.onChannelsReceived();
+    }
+    if ( state == 1 )
+    {
+      Serial.println("Rebooting to LR mode");
+      delay(100);
+      ESP.restart();
+      delay(1000);
+    }
+    state = 0;
+  }
+
+  hxCRSFEncoder.loop( Serial1 );
+}
+
+//=====================================================================
+//=====================================================================
+void loop()
+{
+  esp_task_wdt_reset();
+
+  processIncomingTelemetry();
+  fillOutgoingTelemetry();
+
+  hxrcSlave.loop();
+
+  updateCRSFOutput();
+
+  if (millis() - lastStats > 1000)
+  {
+    lastStats = millis();
+    hxrcSlave.getTransmitterStats().printStats();
+    hxrcSlave.getReceiverStats().printStats();
+  }
+
+  if ( hxrcSlave.getReceiverStats().isFailsafe() )
+  {
+    ArduinoOTA.handle();  
+  }
+
+  if ( 
+      USE_LR_MODE &&
+      (state == 2) && 
+      ((NORMAL_MODE_DELAY_MS) > 0) &&
+      ((millis() - startTime) > (NORMAL_MODE_DELAY_MS) ) 
+      )
+  {
+    //if there is no transmitter connection after 1 minute after powerup, and LR more is enabled, 
+    //switch to normal mode to show AP and allow OTA updates
+
+    Serial.println("Switching to normal mode");
+
+    state = 1;
+
+    if (esp_wifi_set_protocol (WIFI_IF_STA, WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N ) != ESP_OK)
+    {
+      Serial.println("HXRC: Error: Failed to enable normal mode");
+    }
+
+  }
+}
@@ -24,6 +24,12 @@ https://randomnerdtutorials.com/esp32-pinout-reference-gpios/
 
 #define USE_LR_MODE true
 
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
+
 //if there is not transmitter connection after powerup to the specified time,
 //receiver will switch from LR to nomal mode to show AP and allow OTA updates
 //set to 0 to disable
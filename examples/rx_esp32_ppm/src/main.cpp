@@ -64,12 +64,14 @@ void setup()
 
   hxPPMEncoder.init( PPM_CHANNELS_COUNT, PPM_PIN );
 
-  hxrcSlave.init(
-      HXRCConfig(
+  HXRCConfig config(
           USE_WIFI_CHANNEL,
           USE_KEY,
           USE_LR_MODE,
-          LED_BUILTIN, false));
+          LED_BUILTIN, false);
+  config.failsafePeriodMs = USE_FAILSAFE_PERIOD_MS;
+  config.telemetrySizeMax = USE_TELEMETRY_SIZE_MAX;
+  hxrcSlave.init( config );
 
   //REVIEW: receiver does not work if AP is not initialized?
   WiFi.softAP("hxrcrsbus", NULL, USE_WIFI_CHANNEL);
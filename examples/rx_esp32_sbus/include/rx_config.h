@@ -9,11 +9,21 @@ https://randomnerdtutorials.com/esp32-pinout-reference-gpios/
 //inverted SBUS = true ===> normal UART
 #define SBUS_INVERTED  false
 
+//SBUS output speed: SBUS_BAUDRATE (100000) or SBUS_FAST_BAUDRATE (200000)
+#define SBUS_OUTPUT_BAUDRATE SBUS_BAUDRATE
+//SBUS frame period if there are no new packets: SBUS_PERIOD_MS (14) or SBUS_FAST_PERIOD_MS (7)
+#define SBUS_OUTPUT_PERIOD_MS SBUS_PERIOD_MS
+
 #define SBUS_PIN 22
 
 //#define TELEMETRY_BAUDRATE 115200
 #define TELEMETRY_BAUDRATE 57600
 
+//Telemetry stream is MAVLink: periodically send RADIO_STATUS to flight controller, like SiK radio does.
+//txbuf field reports free space in telemetry buffer, so flight controller adapts stream rate to link capacity.
+//Message is inserted between MAVLink frames coming from transmitter.
+#define USE_MAVLINK_RADIO_STATUS false
+
 //=============================================================================
 //Receiver binding
 #define USE_WIFI_CHANNEL 3
@@ -21,6 +31,12 @@ https://randomnerdtutorials.com/esp32-pinout-reference-gpios/
 
 #define USE_LR_MODE true
 
+//Link parameters
+//failsafe is reported if there are no packets from transmitter for this time
+#define USE_FAILSAFE_PERIOD_MS 1000
+//max telemetry bytes in packet to transmitter, up to 128. Smaller packets have better chances of successfull delivery.
+#define USE_TELEMETRY_SIZE_MAX 128
+
 //if there is not transmitter connection after powerup to the specified time,
 //receiver will switch from LR to nomal mode to show AP and allow OTA updates
 //set to 0 to disable
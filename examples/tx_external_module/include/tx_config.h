@@ -1,6 +1,8 @@
 #pragma once
 
 #define USE_SERIAL1_RX_PIN 27  //input pin for Serial1 ( SBUS decoder )
+//SBUS input baudrate: SBUS_BAUDRATE (100000) or SBUS_FAST_BAUDRATE (200000)
+#define USE_SBUS_BAUDRATE SBUS_BAUDRATE
 #define SPORT_PIN 18 //output pin for Serial0 ( SPORT output )
 
 #define CP2102_RX_PIN  1  //if we use Serial0 for SPORT, we setup software serial to output to USB
@@ -16,7 +18,32 @@
 //- HXRCLOG is set to SoftwareSerial
 #define USE_SPORT
 
+//when CRSF input is enabled (instead of SBUS + SPORT):
+//- radio is connected to SPORT_PIN (CRSF pin of external module bay), UART1 in half-duplex mode
+//- link statistics and telemetry from receiver are sent back to radio as CRSF frames
+//- USE_SPORT is disabled, HXRCLOG goes to USB
+//- radio should be configured to send CRSF at CRSF_INPUT_BAUDRATE
+//#define USE_CRSF_INPUT
+#define CRSF_PIN SPORT_PIN
+#define CRSF_INPUT_BAUDRATE CRSF_MODULE_BAUDRATE
+#define CRSF_INPUT_INVERTED false
+
+//PPM input (instead of SBUS) for radios without SBUS output, 4...16 channels.
+//SPORT output is still available.
+//#define USE_PPM_INPUT
+#define PPM_INPUT_PIN USE_SERIAL1_RX_PIN
+//false - positive pulses (most radios), true - negative pulses
+#define PPM_INPUT_INVERTED false
+
 //= Dependent definitions ========================================================
+#ifdef USE_CRSF_INPUT
+#undef USE_SPORT
+#endif
+
+#if defined(USE_CRSF_INPUT) && defined(USE_PPM_INPUT)
+#error "USE_CRSF_INPUT and USE_PPM_INPUT can not be used together"
+#endif
+
 #ifdef USE_SPORT 
 #else
 #endif
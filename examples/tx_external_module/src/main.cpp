@@ -12,6 +12,8 @@
 #include "HX_ESPNOW_RC_Master.h"
 #include "HX_ESPNOW_RC_SerialBuffer.h"
 #include "hx_sbus_decoder.h"
+#include "hx_crsf_decoder.h"
+#include "hx_ppm_decoder.h"
 
 #include "txProfileManager.h"
 
@@ -26,7 +28,13 @@
 
 #define WDT_TIMEOUT_SECONDS 3  
 
+#if defined(USE_CRSF_INPUT)
+static HXCRSFDecoder crsfDecoder;
+#elif defined(USE_PPM_INPUT)
+static HXPPMDecoder ppmDecoder;
+#else
 static HXSBUSDecoder sbusDecoder;
+#endif
 static HC06Interface externalBTSerial;
 
 #ifdef USE_SPORT  
@@ -34,6 +42,8 @@ SoftwareSerial softwareSerial;
 Smartport sport;
 #endif
 
+static unsigned long lastSBUSStats = 0;
+
 //=====================================================================
 //=====================================================================
 void initLedPin()
@@ -94,7 +104,14 @@ void setup()
 
   initLedPin();
 
-  sbusDecoder.init(USE_SERIAL1_RX_PIN);
+#if defined(USE_CRSF_INPUT)
+  crsfDecoder.init(&Serial1, CRSF_PIN, CRSF_INPUT_BAUDRATE, CRSF_INPUT_INVERTED);
+  ModeBase::crsfDecoder = &crsfDecoder;
+#elif defined(USE_PPM_INPUT)
+  ppmDecoder.init(PPM_INPUT_PIN, PPM_INPUT_INVERTED);
+#else
+  sbusDecoder.init(USE_SERIAL1_RX_PIN, USE_SBUS_BAUDRATE);
+#endif
 
   setLed(true);
 
@@ -113,23 +130,80 @@ void setup()
 void  getChannelValues( HXSBUSDecoder* sbusDecoder, HXChannels* channelValues )
 {
   channelValues-> isFailsafe = sbusDecoder->isFailsafe();
-  for ( int i = 0; i < HXRC_CHANNELS_COUNT; i++)
+  channelValues->frameCounter = sbusDecoder->getFrameCounter();
+  channelValues->frameTimeUs = sbusDecoder->getFrameTimeUs();
+  for ( int i = 0; i < HXRC_CHANNELS_COUNT + HXRC_DIGITAL_CHANNELS_COUNT; i++)
   {
     channelValues->channelValue[i] = sbusDecoder->getChannelValueInRange( i, 1000, 2000);
   }
 
 }
 
+//=====================================================================
+//=====================================================================
+void updateSBUSStats( const HXSBUSDecoder* sbusDecoder )
+{
+  const HXSBUSDecoderStats& stats = sbusDecoder->getStats();
+
+#ifdef USE_SPORT
+  sport.setDebug4( stats.intervalMaxUs );
+  sport.setDebug5( stats.framesLost );
+  sport.setDebug6( stats.framesInvalid + stats.gapResyncs + stats.framesMissedByLoop );
+#endif
+
+  if ( millis() - lastSBUSStats > 1000 )
+  {
+    lastSBUSStats = millis();
+    HXRCLOG.printf("SBUS: frames:%u lost:%u fs:%u invalid:%u skipped:%u resync:%u missed:%u interval:%lu/%lu/%luus loop:%luus\n",
+      stats.framesTotal, stats.framesLost, stats.framesFailsafe, stats.framesInvalid, stats.bytesSkipped, stats.gapResyncs, stats.framesMissedByLoop,
+      stats.intervalMinUs, stats.intervalAvgUs, stats.intervalMaxUs, stats.loopIntervalMaxUs );
+  }
+}
+
+//=====================================================================
+//=====================================================================
+void  getChannelValues( HXCRSFDecoder* crsfDecoder, HXChannels* channelValues )
+{
+  channelValues-> isFailsafe = crsfDecoder->isFailsafe();
+  channelValues->frameCounter = crsfDecoder->rcFrames;
+  channelValues->frameTimeUs = crsfDecoder->getRCFrameTimeUs();
+  for ( int i = 0; i < HXRC_CHANNELS_COUNT; i++)
+  {
+    channelValues->channelValue[i] = crsfDecoder->getChannelValueInRange( i, 1000, 2000);
+  }
+}
+
+//=====================================================================
+//=====================================================================
+void  getChannelValues( HXPPMDecoder* ppmDecoder, HXChannels* channelValues )
+{
+  channelValues-> isFailsafe = ppmDecoder->isFailsafe();
+  channelValues->frameCounter = ppmDecoder->getFrameCounter();
+  channelValues->frameTimeUs = ppmDecoder->getFrameTimeUs();
+  for ( int i = 0; i < HXRC_CHANNELS_COUNT; i++)
+  {
+    channelValues->channelValue[i] = ppmDecoder->getChannelValueInRange( i, 1000, 2000);
+  }
+}
+
 //=====================================================================
 //=====================================================================
 void loop()
 {
   esp_task_wdt_reset();
 
-  sbusDecoder.loop();
-
   HXChannels channelValues;
+#if defined(USE_CRSF_INPUT)
+  crsfDecoder.loop();
+  getChannelValues( &crsfDecoder, &channelValues );
+#elif defined(USE_PPM_INPUT)
+  ppmDecoder.loop();
+  getChannelValues( &ppmDecoder, &channelValues );
+#else
+  sbusDecoder.loop();
   getChannelValues( &sbusDecoder, &channelValues );
+  updateSBUSStats( &sbusDecoder );
+#endif
 
 
 #ifdef USE_SPORT
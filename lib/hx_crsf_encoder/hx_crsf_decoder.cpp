@@ -0,0 +1,277 @@
+#include "hx_crsf_decoder.h"
+
+#if defined(ESP32)
+#include "soc/gpio_sig_map.h"
+
+//UART signals in GPIO matrix, by UART index
+static const uint8_t uartRXSignal[] = { U0RXD_IN_IDX, U1RXD_IN_IDX, U2RXD_IN_IDX };
+static const uint8_t uartTXSignal[] = { U0TXD_OUT_IDX, U1TXD_OUT_IDX, U2TXD_OUT_IDX };
+#endif
+
+//=====================================================================
+//=====================================================================
+HXCRSFDecoder::HXCRSFDecoder()
+{
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::init( HardwareSerial* serial, int pin, uint32_t baudrate, bool invert )
+{
+    this->serial = serial;
+    this->uartIndex = -1;
+    this->pin = pin;
+    this->invert = invert;
+    this->baudrate = baudrate;
+
+    this->parser.reset();
+    for ( int i = 0; i < CRSF_CHANNELS_COUNT; i++ )
+    {
+        this->channels[i] = CRSF_CHANNEL_VALUE_MID;
+    }
+    this->lastRCFrameTime = millis() - CRSF_INPUT_FAILSAFE_MS;
+    this->lastRCFrameTimeUs = micros();
+    this->rcPeriodUs = 0;
+    this->rcFrameTimeValid = false;
+
+    memset( &this->linkStatistics, 0, sizeof( this->linkStatistics ) );
+    this->lastLinkStatisticsTime = millis();
+
+    this->telemetryParser.reset();
+    this->telemetryQueueCount = 0;
+
+    this->rcFrames = 0;
+    this->repliesSent = 0;
+    this->repliesSkipped = 0;
+    this->telemetryFramesDropped = 0;
+
+#if defined(ESP8266)
+    serial->begin( baudrate, SERIAL_8N1 );
+#elif defined(ESP32)
+    this->uartIndex = serial == &Serial ? 0 : serial == &Serial1 ? 1 : serial == &Serial2 ? 2 : -1;
+    if ( this->uartIndex < 0 )
+    {
+        Serial.println("HXRC: Error: CRSF input: unknown serial port, replies are disabled");
+    }
+
+    serial->begin( baudrate, SERIAL_8N1, pin, -1, invert );
+    setRX();
+#endif
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::setTX()
+{
+#if defined(ESP32)
+    //feed idle level to UART RX while transmitting
+    pinMatrixInDetach( uartRXSignal[this->uartIndex], !this->invert, false );
+    pinMode( this->pin, OUTPUT );
+    pinMatrixOutAttach( this->pin, uartTXSignal[this->uartIndex], false, false );
+#endif
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::setRX()
+{
+#if defined(ESP32)
+    if ( this->uartIndex < 0 ) return;
+    pinMatrixOutDetach( this->pin, false, false );
+    pinMode( this->pin, INPUT );
+    pinMatrixInAttach( this->pin, uartRXSignal[this->uartIndex], false );
+#endif
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::loop()
+{
+    uint8_t buffer[64];
+    uint8_t rcFramesCount = 0;
+    //RC frame was completed by the last byte read
+    bool rcFrameAtEnd = false;
+    unsigned long t = 0;
+
+    while ( true )
+    {
+        int n = this->serial->available();
+        if ( n <= 0 ) break;
+        if ( n > (int)sizeof( buffer ) ) n = sizeof( buffer );
+        n = this->serial->readBytes( buffer, n );
+
+        t = micros();
+        for ( int i = 0; i < n; i++ )
+        {
+            rcFrameAtEnd = this->parser.parseByte( buffer[i] ) && onFrame();
+            if ( rcFrameAtEnd && ( rcFramesCount < 255 ) ) rcFramesCount++;
+        }
+    }
+
+    if ( rcFramesCount == 0 ) return;
+
+    //arrival time is known only if the single frame was the last data in UART
+    bool inTime = rcFrameAtEnd && ( rcFramesCount == 1 );
+    onRCFrameTime( t, inTime );
+
+    if ( inTime )
+    {
+        sendReply();
+    }
+    else
+    {
+        this->repliesSkipped++;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+//returns true if frame is RC frame
+bool HXCRSFDecoder::onFrame()
+{
+    const uint8_t* frame = this->parser.getFrame();
+    if ( ( frame[2] != CRSF_FRAMETYPE_RC_CHANNELS_PACKED ) || ( frame[1] != CRSF_RC_CHANNELS_PAYLOAD_SIZE + 2 ) ) return false;
+
+    HXCRSFUnpackChannels( frame + 3, this->channels );
+
+    this->lastRCFrameTime = millis();
+    this->rcFrames++;
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+//RC period is measured only between frames with known arrival time
+void HXCRSFDecoder::onRCFrameTime( unsigned long timeUs, bool valid )
+{
+    unsigned long dt = timeUs - this->lastRCFrameTimeUs;
+    if ( valid && this->rcFrameTimeValid && ( dt < 100000 ) )
+    {
+        this->rcPeriodUs = this->rcPeriodUs == 0 ? dt : ( this->rcPeriodUs * 7 + dt ) / 8;
+    }
+
+    this->lastRCFrameTimeUs = timeUs;
+    this->rcFrameTimeValid = valid;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXCRSFDecoder::writeFrame( const uint8_t* frame, uint8_t len )
+{
+    if ( this->rcPeriodUs == 0 ) return false;
+#if defined(ESP32)
+    if ( this->uartIndex < 0 ) return false;
+#endif
+
+    //reply should be complete before next RC frame starts. 10 bits per byte.
+    unsigned long replyTimeUs = len * 10 * 1000000UL / this->baudrate;
+    unsigned long rcFrameTimeUs = ( CRSF_RC_CHANNELS_PAYLOAD_SIZE + 4 ) * 10 * 1000000UL / this->baudrate;
+    if ( ( micros() - this->lastRCFrameTimeUs ) + replyTimeUs + rcFrameTimeUs + CRSF_REPLY_GUARD_US > this->rcPeriodUs )
+    {
+        this->repliesSkipped++;
+        return false;
+    }
+
+    setTX();
+    this->serial->write( frame, len );
+    this->serial->flush();  //wait for transmission complete
+    setRX();
+    this->repliesSent++;
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::sendReply()
+{
+    unsigned long t = millis();
+
+    if ( ( t - this->lastLinkStatisticsTime ) >= CRSF_MODULE_LINK_STATISTICS_PERIOD_MS )
+    {
+        uint8_t frame[CRSF_LINK_STATISTICS_PAYLOAD_SIZE + 4];
+        frame[0] = CRSF_ADDRESS_RADIO_TRANSMITTER;
+        frame[1] = CRSF_LINK_STATISTICS_PAYLOAD_SIZE + 2;
+        frame[2] = CRSF_FRAMETYPE_LINK_STATISTICS;
+        memcpy( frame + 3, &this->linkStatistics, CRSF_LINK_STATISTICS_PAYLOAD_SIZE );
+        frame[CRSF_LINK_STATISTICS_PAYLOAD_SIZE + 3] = HXCRSFCrc8( frame + 2, CRSF_LINK_STATISTICS_PAYLOAD_SIZE + 1 );
+        if ( writeFrame( frame, sizeof( frame ) ) ) this->lastLinkStatisticsTime = t;
+        return;
+    }
+
+    if ( this->telemetryQueueCount > 0 )
+    {
+        uint8_t len = this->telemetryQueue[1] + 2;
+        if ( !writeFrame( this->telemetryQueue, len ) ) return;
+        this->telemetryQueueCount -= len;
+        memmove( this->telemetryQueue, this->telemetryQueue + len, this->telemetryQueueCount );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::writeTelemetry( const uint8_t* data, uint16_t len )
+{
+    while ( len-- )
+    {
+        if ( !this->telemetryParser.parseByte( *data++ ) ) continue;
+
+        const uint8_t* frame = this->telemetryParser.getFrame();
+        uint8_t frameLen = this->telemetryParser.getFrameLength();
+
+        //link statistics and channels are generated by module
+        if ( ( frame[2] == CRSF_FRAMETYPE_LINK_STATISTICS ) || ( frame[2] == CRSF_FRAMETYPE_RC_CHANNELS_PACKED ) ) continue;
+
+        if ( this->telemetryQueueCount + frameLen > CRSF_TELEMETRY_QUEUE_SIZE )
+        {
+            this->telemetryFramesDropped++;
+            continue;
+        }
+
+        memcpy( this->telemetryQueue + this->telemetryQueueCount, frame, frameLen );
+        this->telemetryQueueCount += frameLen;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFDecoder::setLinkStatistics( const HXCRSFLinkStatistics& stats )
+{
+    this->linkStatistics = stats;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXCRSFDecoder::isFailsafe() const
+{
+    return ( millis() - this->lastRCFrameTime ) >= CRSF_INPUT_FAILSAFE_MS;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXCRSFDecoder::getRCPeriodUs() const
+{
+    return this->rcPeriodUs;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXCRSFDecoder::getRCFrameTimeUs() const
+{
+    return this->lastRCFrameTimeUs;
+}
+
+//=====================================================================
+//=====================================================================
+//returns 1000..2000
+uint16_t HXCRSFDecoder::getChannelValue( uint8_t index ) const
+{
+    return index < CRSF_CHANNELS_COUNT ? HXCRSFChannelToUs( this->channels[index] ) : 1000;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXCRSFDecoder::getChannelValueInRange( uint8_t index, uint16_t from, uint16_t to ) const
+{
+    if ( index >= CRSF_CHANNELS_COUNT ) return from;
+    return map( constrain( this->channels[index], CRSF_CHANNEL_VALUE_MIN, CRSF_CHANNEL_VALUE_MAX ), CRSF_CHANNEL_VALUE_MIN, CRSF_CHANNEL_VALUE_MAX, from, to );
+}
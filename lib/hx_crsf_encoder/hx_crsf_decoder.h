@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "hx_crsf_protocol.h"
+
+//Radio to external module baudrate, configured in radio
+#define CRSF_MODULE_BAUDRATE            400000
+
+#define CRSF_INPUT_FAILSAFE_MS          200
+#define CRSF_MODULE_LINK_STATISTICS_PERIOD_MS  200
+
+//minimum gap between end of reply and start of next RC frame
+#define CRSF_REPLY_GUARD_US             100
+
+//telemetry frames waiting for reply slot
+#define CRSF_TELEMETRY_QUEUE_SIZE       512
+
+//=====================================================================
+//=====================================================================
+//CRSF input from radio in external module bay.
+//Radio sends RC_CHANNELS_PACKED frames on single half-duplex wire. Module answers with one frame
+//(LINK_STATISTICS or telemetry) right after RC frame. Reply is skipped if it can not complete
+//before next RC frame (measured RC period), so it never collides with radio transmission.
+//Reply is sent only if RC frame was the last data in UART: if loop() is late and several frames are waiting,
+//their arrival time is unknown, reply is skipped and frames are not used for RC period measurement.
+class HXCRSFDecoder
+{
+private:
+    HardwareSerial* serial;
+    //ESP32: UART of serial, -1 - unknown, half-duplex replies are disabled
+    int8_t uartIndex;
+    int pin;
+    bool invert;
+    uint32_t baudrate;
+
+    HXCRSFFrameParser parser;
+
+    uint16_t channels[CRSF_CHANNELS_COUNT];  //CRSF values
+    unsigned long lastRCFrameTime;
+    unsigned long lastRCFrameTimeUs;
+    //measured RC frame period, 0 - unknown
+    unsigned long rcPeriodUs;
+    //lastRCFrameTimeUs is arrival time of the frame, not time of late UART read
+    bool rcFrameTimeValid;
+
+    HXCRSFLinkStatistics linkStatistics;
+    unsigned long lastLinkStatisticsTime;
+
+    HXCRSFFrameParser telemetryParser;
+    uint8_t telemetryQueue[CRSF_TELEMETRY_QUEUE_SIZE];
+    uint16_t telemetryQueueCount;
+
+    void setTX();
+    void setRX();
+
+    bool onFrame();
+    void onRCFrameTime( unsigned long timeUs, bool valid );
+    void sendReply();
+    bool writeFrame( const uint8_t* frame, uint8_t len );
+
+public:
+    uint32_t rcFrames;
+    uint32_t repliesSent;
+    //reply slot missed because loop() was called too late, or several RC frames were waiting in UART
+    uint32_t repliesSkipped;
+    uint32_t telemetryFramesDropped;
+
+    HXCRSFDecoder();
+
+    //ESP32: RX and TX signals of UART are switched on the same pin. serial should be Serial, Serial1 or Serial2,
+    //otherwise only input is decoded and replies are not sent.
+    void init( HardwareSerial* serial, int pin, uint32_t baudrate = CRSF_MODULE_BAUDRATE, bool invert = false );
+
+    void loop();
+
+    bool isFailsafe() const;
+    uint32_t getRCPeriodUs() const;
+    //micros() when last RC frame was received
+    unsigned long getRCFrameTimeUs() const;
+
+    uint16_t getChannelValue( uint8_t index ) const;
+    uint16_t getChannelValueInRange( uint8_t index, uint16_t from, uint16_t to ) const;
+
+    void setLinkStatistics( const HXCRSFLinkStatistics& stats );
+
+    //CRSF telemetry byte stream received from receiver. Complete frames are queued for sending to radio.
+    void writeTelemetry( const uint8_t* data, uint16_t len );
+};
@@ -0,0 +1,131 @@
+#include "hx_crsf_encoder.h"
+
+//=====================================================================
+//=====================================================================
+HXCRSFEncoder::HXCRSFEncoder()
+{
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFEncoder::init( HardwareSerial& serial, int rx_pin, int tx_pin, uint32_t baudrate )
+{
+    this->failsafe = true;
+    for ( int i = 0; i < CRSF_CHANNELS_COUNT; i++ )
+    {
+        this->setChannelValue( i, 1000 );
+    }
+
+    this->newData = false;
+    this->lastRCFrameTime = millis();
+    this->lastLinkStatisticsTime = millis();
+
+    memset( &this->linkStatistics, 0, sizeof( this->linkStatistics ) );
+
+    this->parser.reset();
+    this->inFrameReady = false;
+
+#if defined(ESP8266)
+    serial.begin( baudrate, SERIAL_8N1 );
+#elif defined(ESP32)
+    serial.begin( baudrate, SERIAL_8N1, rx_pin, tx_pin, false );
+#endif
+}
+
+//=====================================================================
+//=====================================================================
+bool HXCRSFEncoder::writeFrame( HardwareSerial& serial, uint8_t type, const uint8_t* payload, uint8_t len )
+{
+    if ( serial.availableForWrite() < len + 4 ) return false;
+
+    uint8_t frame[CRSF_FRAME_SIZE_MAX];
+    frame[0] = CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = len + 2;  //type + payload + crc
+    frame[2] = type;
+    memcpy( frame + 3, payload, len );
+    frame[len + 3] = HXCRSFCrc8( frame + 2, len + 1 );
+
+    serial.write( frame, len + 4 );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFEncoder::loop( HardwareSerial& serial )
+{
+    unsigned long t = millis();
+
+    if ( !this->failsafe && ( this->newData || ( ( t - this->lastRCFrameTime ) >= CRSF_RC_PERIOD_MS ) ) )
+    {
+        uint8_t payload[CRSF_RC_CHANNELS_PAYLOAD_SIZE];
+        HXCRSFPackChannels( this->channels, payload );
+        if ( writeFrame( serial, CRSF_FRAMETYPE_RC_CHANNELS_PACKED, payload, CRSF_RC_CHANNELS_PAYLOAD_SIZE ) )
+        {
+            this->newData = false;
+            this->lastRCFrameTime = t;
+        }
+    }
+
+    if ( ( t - this->lastLinkStatisticsTime ) >= CRSF_LINK_STATISTICS_PERIOD_MS )
+    {
+        if ( writeFrame( serial, CRSF_FRAMETYPE_LINK_STATISTICS, (const uint8_t*)&this->linkStatistics, CRSF_LINK_STATISTICS_PAYLOAD_SIZE ) )
+        {
+            this->lastLinkStatisticsTime = t;
+        }
+    }
+
+    while ( !this->inFrameReady && ( serial.available() > 0 ) )
+    {
+        this->inFrameReady = this->parser.parseByte( serial.read() );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXCRSFEncoder::getTelemetryFrame( uint8_t* buffer )
+{
+    if ( !this->inFrameReady ) return 0;
+
+    uint8_t len = this->parser.getFrameLength();
+    memcpy( buffer, this->parser.getFrame(), len );
+
+    this->inFrameReady = false;
+    return len;
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFEncoder::setFailsafe( bool failsafe )
+{
+    this->failsafe = failsafe;
+}
+
+//=====================================================================
+//=====================================================================
+//input value is in range 1000..2000
+void HXCRSFEncoder::setChannelValue( uint8_t index, uint16_t value )
+{
+    if ( index < CRSF_CHANNELS_COUNT )
+    {
+        this->channels[index] = HXCRSFChannelFromUs( value );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFEncoder::onChannelsReceived()
+{
+    this->newData = true;
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFEncoder::setLinkStatistics( uint8_t uplinkRSSIDbm, uint8_t uplinkLQ, int8_t uplinkSNR, uint8_t downlinkRSSIDbm, uint8_t downlinkLQ )
+{
+    this->linkStatistics.uplinkRSSIAnt1 = uplinkRSSIDbm;
+    this->linkStatistics.uplinkRSSIAnt2 = uplinkRSSIDbm;
+    this->linkStatistics.uplinkLQ = uplinkLQ;
+    this->linkStatistics.uplinkSNR = uplinkSNR;
+    this->linkStatistics.downlinkRSSI = downlinkRSSIDbm;
+    this->linkStatistics.downlinkLQ = downlinkLQ;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "hx_crsf_protocol.h"
+
+//resend RC frame every ?ms if there is no new data
+#define CRSF_RC_PERIOD_MS               20
+#define CRSF_LINK_STATISTICS_PERIOD_MS  200
+
+//=====================================================================
+//=====================================================================
+//CRSF output to flight controller: RC_CHANNELS_PACKED and LINK_STATISTICS frames.
+//Telemetry frames sent by flight controller are parsed and can be read with getTelemetryFrame().
+//Failsafe is signalled by stopping RC frames, like CRSF receivers do.
+class HXCRSFEncoder
+{
+private:
+    bool failsafe;
+    uint16_t channels[CRSF_CHANNELS_COUNT];  //CRSF values
+
+    bool newData;
+    unsigned long lastRCFrameTime;
+    unsigned long lastLinkStatisticsTime;
+
+    HXCRSFLinkStatistics linkStatistics;
+
+    //incoming telemetry frame
+    HXCRSFFrameParser parser;
+    bool inFrameReady;
+
+    bool writeFrame( HardwareSerial& serial, uint8_t type, const uint8_t* payload, uint8_t len );
+
+public:
+    HXCRSFEncoder();
+
+    //ESP8266: only UART0 (Serial) supports RX, pins are ignored
+    void init( HardwareSerial& serial, int rx_pin, int tx_pin, uint32_t baudrate = CRSF_BAUDRATE );
+
+    void setFailsafe( bool failsafe );
+    //input value is in range 1000..2000
+    void setChannelValue( uint8_t index, uint16_t value );
+
+    //new RC frame was received: channel values will be sent on next loop()
+    void onChannelsReceived();
+
+    //rssi: positive value in dbm, 70 means -70dbm. lq: 0..100
+    void setLinkStatistics( uint8_t uplinkRSSIDbm, uint8_t uplinkLQ, int8_t uplinkSNR, uint8_t downlinkRSSIDbm, uint8_t downlinkLQ );
+
+    void loop( HardwareSerial& serial );
+
+    //copies complete telemetry frame from flight controller into buffer (CRSF_FRAME_SIZE_MAX bytes)
+    //returns frame length or 0
+    uint8_t getTelemetryFrame( uint8_t* buffer );
+};
+
@@ -0,0 +1,154 @@
+#include "hx_crsf_protocol.h"
+
+//=====================================================================
+//=====================================================================
+uint8_t HXCRSFCrc8( const uint8_t* data, uint8_t len )
+{
+    uint8_t crc = 0;
+    while ( len-- )
+    {
+        crc ^= *data++;
+        for ( int i = 0; i < 8; i++ )
+        {
+            crc = ( crc & 0x80 ) ? ( ( crc << 1 ) ^ 0xD5 ) : ( crc << 1 );
+        }
+    }
+    return crc;
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFPackChannels( const uint16_t* channels, uint8_t* payload )
+{
+    uint8_t pos = 0;
+    uint32_t bits = 0;
+    uint8_t bitsCount = 0;
+    for ( int i = 0; i < CRSF_CHANNELS_COUNT; i++ )
+    {
+        bits |= ( (uint32_t)( channels[i] & 0x7ff ) ) << bitsCount;
+        bitsCount += 11;
+        while ( bitsCount >= 8 )
+        {
+            payload[pos++] = (uint8_t)bits;
+            bits >>= 8;
+            bitsCount -= 8;
+        }
+    }
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFUnpackChannels( const uint8_t* payload, uint16_t* channels )
+{
+    uint32_t bits = 0;
+    uint8_t bitsCount = 0;
+    for ( int i = 0; i < CRSF_CHANNELS_COUNT; i++ )
+    {
+        while ( bitsCount < 11 )
+        {
+            bits |= ( (uint32_t)*payload++ ) << bitsCount;
+            bitsCount += 8;
+        }
+        channels[i] = bits & 0x7ff;
+        bits >>= 11;
+        bitsCount -= 11;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXCRSFChannelFromUs( uint16_t value )
+{
+    int32_t v = ( ( (int32_t)value - 1500 ) * 8 ) / 5 + CRSF_CHANNEL_VALUE_MID;
+    if ( v < CRSF_CHANNEL_VALUE_MIN ) v = CRSF_CHANNEL_VALUE_MIN;
+    if ( v > CRSF_CHANNEL_VALUE_MAX ) v = CRSF_CHANNEL_VALUE_MAX;
+    return v;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXCRSFChannelToUs( uint16_t value )
+{
+    return ( ( (int32_t)value - CRSF_CHANNEL_VALUE_MID ) * 5 ) / 8 + 1500;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXCRSFPowerFromDbm( uint8_t dbm )
+{
+    if ( dbm == 0 ) return CRSF_POWER_0_MW;
+    if ( dbm <= 10 ) return CRSF_POWER_10_MW;
+    if ( dbm <= 14 ) return CRSF_POWER_25_MW;
+    if ( dbm <= 17 ) return CRSF_POWER_50_MW;
+    return CRSF_POWER_100_MW;
+}
+
+//=====================================================================
+//=====================================================================
+HXCRSFFrameParser::HXCRSFFrameParser()
+{
+    this->framesTotal = 0;
+    this->crcErrors = 0;
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXCRSFFrameParser::reset()
+{
+    this->count = 0;
+    this->complete = false;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXCRSFFrameParser::parseByte( uint8_t c )
+{
+    if ( this->complete ) reset();
+
+    if ( this->count == 0 )
+    {
+        if ( ( c != CRSF_ADDRESS_FLIGHT_CONTROLLER ) && ( c != CRSF_ADDRESS_RADIO_TRANSMITTER ) &&
+             ( c != CRSF_ADDRESS_CRSF_RECEIVER ) && ( c != CRSF_ADDRESS_CRSF_TRANSMITTER ) ) return false;
+    }
+    else if ( this->count == 1 )
+    {
+        //type + payload + crc
+        if ( ( c < 2 ) || ( c > CRSF_FRAME_SIZE_MAX - 2 ) )
+        {
+            this->count = 0;
+            return false;
+        }
+    }
+
+    this->frame[ this->count++ ] = c;
+
+    if ( ( this->count > 2 ) && ( this->count == this->frame[1] + 2 ) )
+    {
+        if ( HXCRSFCrc8( this->frame + 2, this->frame[1] - 1 ) == this->frame[ this->count - 1 ] )
+        {
+            this->framesTotal++;
+            this->complete = true;
+            return true;
+        }
+
+        this->crcErrors++;
+        this->count = 0;
+    }
+
+    return false;
+}
+
+//=====================================================================
+//=====================================================================
+const uint8_t* HXCRSFFrameParser::getFrame() const
+{
+    return this->frame;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXCRSFFrameParser::getFrameLength() const
+{
+    return this->complete ? this->count : 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+//https://github.com/crsf-wg/crsf/wiki
+
+#define CRSF_BAUDRATE                   420000
+
+#define CRSF_ADDRESS_FLIGHT_CONTROLLER  0xC8
+#define CRSF_ADDRESS_RADIO_TRANSMITTER  0xEA
+#define CRSF_ADDRESS_CRSF_RECEIVER      0xEC
+#define CRSF_ADDRESS_CRSF_TRANSMITTER   0xEE
+
+#define CRSF_FRAMETYPE_LINK_STATISTICS      0x14
+#define CRSF_FRAMETYPE_RC_CHANNELS_PACKED   0x16
+
+//address, length, type, payload(up to 60), crc
+#define CRSF_FRAME_SIZE_MAX             64
+#define CRSF_PAYLOAD_SIZE_MAX           ( CRSF_FRAME_SIZE_MAX - 4 )
+
+#define CRSF_CHANNELS_COUNT             16
+#define CRSF_RC_CHANNELS_PAYLOAD_SIZE   22
+#define CRSF_LINK_STATISTICS_PAYLOAD_SIZE   10
+
+//172..1811 = 988us..2012us
+#define CRSF_CHANNEL_VALUE_MIN          172
+#define CRSF_CHANNEL_VALUE_MID          992
+#define CRSF_CHANNEL_VALUE_MAX          1811
+
+//uplink TX power enum
+#define CRSF_POWER_0_MW                 0
+#define CRSF_POWER_10_MW                1
+#define CRSF_POWER_25_MW                2
+#define CRSF_POWER_100_MW               3
+#define CRSF_POWER_50_MW                8
+
+#pragma pack (push)
+#pragma pack (1)
+
+//=====================================================================
+//=====================================================================
+//rssi: positive value in dbm, 70 means -70dbm. lq: 0..100
+typedef struct
+{
+    uint8_t uplinkRSSIAnt1;
+    uint8_t uplinkRSSIAnt2;
+    uint8_t uplinkLQ;
+    int8_t uplinkSNR;
+    uint8_t activeAntenna;
+    uint8_t rfMode;
+    uint8_t uplinkTXPower;
+    uint8_t downlinkRSSI;
+    uint8_t downlinkLQ;
+    int8_t downlinkSNR;
+} HXCRSFLinkStatistics;
+
+#pragma pack (pop)
+
+//CRC8 DVB-S2, poly 0xD5
+extern uint8_t HXCRSFCrc8( const uint8_t* data, uint8_t len );
+
+//16 channels, 11 bits each, LSB first
+extern void HXCRSFPackChannels( const uint16_t* channels, uint8_t* payload );
+extern void HXCRSFUnpackChannels( const uint8_t* payload, uint16_t* channels );
+
+//1000..2000 <=> CRSF value
+extern uint16_t HXCRSFChannelFromUs( uint16_t value );
+extern uint16_t HXCRSFChannelToUs( uint16_t value );
+
+extern uint8_t HXCRSFPowerFromDbm( uint8_t dbm );
+
+//=====================================================================
+//=====================================================================
+//Collects CRSF frame: address, length, type, payload, crc.
+class HXCRSFFrameParser
+{
+private:
+    uint8_t frame[CRSF_FRAME_SIZE_MAX];
+    uint8_t count;
+    bool complete;
+
+public:
+    //frames with valid/invalid CRC
+    uint32_t framesTotal;
+    uint32_t crcErrors;
+
+    HXCRSFFrameParser();
+
+    void reset();
+
+    //returns true if frame with valid CRC is complete. Frame is available until next parseByte() call.
+    bool parseByte( uint8_t c );
+
+    const uint8_t* getFrame() const;
+    uint8_t getFrameLength() const;
+};
@@ -9,6 +9,11 @@ HXRCBase::HXRCBase()
     receivedSequenceId = 0xffff;    
     waitAck = false;
     memset(peerMac,0,6);
+
+    telemetryMux.streams[HXRC_STREAM_CONTROL].init( &incomingControlBuffer, &outgoingControlBuffer, 1 );
+    telemetryMux.streams[HXRC_STREAM_DEFAULT].init( &incomingTelemetryBuffer, &outgoingTelemetryBuffer, HXRC_STREAM_DEFAULT_WEIGHT_DEFAULT );
+    telemetryMux.streams[HXRC_STREAM_BULK].init( &incomingBulkBuffer, &outgoingBulkBuffer, HXRC_STREAM_BULK_WEIGHT_DEFAULT );
+    telemetryMux.streams[HXRC_STREAM_DEFAULT].setCompression( &telemetryCompressor, &telemetryDecompressor );
 }
 
 //=====================================================================
@@ -23,14 +28,43 @@ bool HXRCBase::init( HXRCConfig config )
 {
     this->config = config;
 
+    this->transmitterStats.failsafePeriodMs = config.failsafePeriodMs;
+    this->receiverStats.failsafePeriodMs = config.failsafePeriodMs;
     this->transmitterStats.reset();
     this->receiverStats.reset();
+    this->transmitterStats.linkState.init( config.signalHoldFrames, config.failsafeFrames, config.failsafePeriodMs );
+    this->receiverStats.linkState.init( config.signalHoldFrames, config.failsafeFrames, config.failsafePeriodMs );
 
     HXRCInitLedPin(config);
 
     this->A1 = 0;
     this->A2 = 0;
 
+    this->wifiChannel = config.wifi_channel;
+    this->pendingChannel = 0;
+    this->prevChannel = 0;
+
+    this->txPowerController.init( config.adaptiveTxPower );
+
+    this->telemetryMux.streams[HXRC_STREAM_DEFAULT].enableCompression( config.telemetryCompression );
+
+    this->outgoingMavlinkQueue.reset();
+    this->outgoingMavlinkQueue.setValidatedInput( config.mavlinkFrameQueueValidatedInput );
+    this->telemetryMux.streams[HXRC_STREAM_DEFAULT].setBufferLimit( 0 );
+    if ( config.mavlinkFrameQueue )
+    {
+        this->telemetryMux.streams[HXRC_STREAM_DEFAULT].setOutgoingBuffer( &this->outgoingMavlinkQueue );
+        this->transmitterStats.pMavlinkQueue = &this->outgoingMavlinkQueue;
+    }
+    else
+    {
+        this->telemetryMux.streams[HXRC_STREAM_DEFAULT].setOutgoingBuffer( &this->outgoingTelemetryBuffer );
+        this->telemetryMux.streams[HXRC_STREAM_DEFAULT].setBufferLimit( config.telemetryBufferLimit );
+        this->transmitterStats.pMavlinkQueue = NULL;
+    }
+
+    this->sendQueue.reset();
+
     senderState = HXRCSS_READY_TO_SEND;
 
     return true;
@@ -40,9 +74,15 @@ bool HXRCBase::init( HXRCConfig config )
 //=====================================================================
 void HXRCBase::loop()
 {
+    //every packet is acknowledged by reply packet, so acknowledges come at rate of incoming packets
+    transmitterStats.packetPeriodMs = receiverStats.getPacketPeriodMs();
     transmitterStats.update();
     receiverStats.update();
 
+    updateChannelSwitch();
+
+    this->txPowerController.update( this->receiverStats.getRemoteRSSIDbm(), this->transmitterStats.getMsSinceLastAck(), this->config.getPacketPeriodMs() );
+
     updateLed( this->config.ledPin, this->config.ledPinInverted);
 }
 
@@ -88,14 +128,84 @@ void HXRCBase::updateLed( int8_t ledPin, bool ledPinInverted )
 //=====================================================================
 uint16_t HXRCBase::getIncomingTelemetry(uint16_t maxSize, uint8_t* pBuffer)
 {
-    return this->incomingTelemetryBuffer.receiveUpTo( maxSize, pBuffer);
+    return getIncomingTelemetry( HXRC_STREAM_DEFAULT, maxSize, pBuffer );
 }
 
 //=====================================================================
 //=====================================================================
 bool HXRCBase::sendOutgoingTelemetry( uint8_t* ptr, uint16_t size )
 {
-    return this->outgoingTelemetryBuffer.send( ptr, size );
+    return sendOutgoingTelemetry( HXRC_STREAM_DEFAULT, ptr, size );
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCBase::getIncomingTelemetry(uint8_t streamId, uint16_t maxSize, uint8_t* pBuffer)
+{
+    if ( streamId >= HXRC_STREAMS_COUNT ) return 0;
+    return this->telemetryMux.streams[streamId].receiveUpTo( maxSize, pBuffer );
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCBase::sendOutgoingTelemetry( uint8_t streamId, uint8_t* ptr, uint16_t size )
+{
+    if ( streamId >= HXRC_STREAMS_COUNT ) return false;
+    return this->telemetryMux.streams[streamId].send( ptr, size );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCBase::setStreamWeight( uint8_t streamId, uint8_t weight )
+{
+    if ( streamId >= HXRC_STREAMS_COUNT ) return;
+    this->telemetryMux.streams[streamId].setWeight( weight );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCBase::setStreamRateLimit( uint8_t streamId, uint16_t bytesPerSecond )
+{
+    if ( streamId >= HXRC_STREAMS_COUNT ) return;
+    this->telemetryMux.streams[streamId].setRateLimit( bytesPerSecond );
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCBase::fillOutgoingTelemetry( uint8_t* data, uint8_t maxLen, unsigned long t, uint8_t* pLen )
+{
+    uint16_t bytes[HXRC_STREAMS_COUNT];
+    uint16_t rawBytes[HXRC_STREAMS_COUNT];
+    unsigned long delayMs[HXRC_STREAMS_COUNT];
+
+    uint8_t reason = this->telemetryMux.checkCoalesce( t, maxLen, this->config.telemetryCoalesceMs, this->config.telemetryCoalesceBytes );
+    if ( reason == HXRC_COALESCE_HOLD )
+    {
+        *pLen = 0;
+        return false;
+    }
+
+    uint8_t len = this->telemetryMux.fill( data, maxLen, t, bytes, rawBytes, delayMs );
+    this->transmitterStats.onStreamsSent( bytes, rawBytes, delayMs );
+    this->transmitterStats.onTelemetryCommit( reason, len, maxLen );
+    *pLen = len;
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCBase::processIncomingTelemetry( const uint8_t* data, uint8_t len, uint16_t sequenceId )
+{
+    uint16_t bytes[HXRC_STREAMS_COUNT];
+
+    //receivedSequenceId is updated after this call
+    bool sequenceGap = (uint16_t)( sequenceId - this->receivedSequenceId ) != 1;
+
+    if ( !this->telemetryMux.parse( data, len, sequenceGap, bytes ) )
+    {
+        this->receiverStats.onTelemetryOverflow();
+    }
+    this->receiverStats.onStreamsReceived( bytes, this->telemetryMux.desyncDropCount );
 }
 
 //=====================================================================
@@ -105,3 +215,115 @@ const uint8_t* HXRCBase::getPeerMac() const
     return this->peerMac;
 }
 
+//=====================================================================
+//=====================================================================
+uint8_t HXRCBase::getWifiChannel() const
+{
+    return this->wifiChannel;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCBase::canSend() const
+{
+    return ( this->senderState != HXRCSS_INIT ) && this->sendQueue.canSend();
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCBase::sendFrame( uint16_t packetId, const uint8_t* data, size_t len, unsigned long t )
+{
+    uint8_t depth = this->sendQueue.getCount();
+
+    this->sendQueue.reserve( packetId, t );
+    if ( !this->sendQueue.canSend() ) this->senderState = HXRCSS_WAIT_SEND_FINISH;
+
+    esp_err_t result = esp_now_send(BROADCAST_MAC, (uint8_t *) data, len );
+    if (result != ESP_OK) 
+    {
+        this->sendQueue.cancel();
+        this->senderState = HXRCSS_READY_TO_SEND;
+        this->transmitterStats.onPacketSendError();
+        return false;
+    }
+
+    this->transmitterStats.onPacketQueued( depth + 1 );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+//called from send callback
+void HXRCBase::onFrameSent( bool success )
+{
+    if( !success )
+    {
+        this->transmitterStats.onPacketSendError();
+    }
+    this->transmitterStats.onPacketSendComplete( this->sendQueue.complete() );
+    this->senderState = HXRCSS_READY_TO_SEND;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCBase::getTxPowerDbm() const
+{
+    return this->txPowerController.getPowerDbm();
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCBase::getOutgoingTelemetryBufferFill()
+{
+    uint32_t size = this->config.mavlinkFrameQueue ? HXRC_MAVLINK_QUEUE_SIZE : HXRC_TELEMETRY_BUFFER_SIZE;
+    if ( !this->config.mavlinkFrameQueue && ( this->config.telemetryBufferLimit > 0 ) && ( this->config.telemetryBufferLimit < size ) )
+    {
+        size = this->config.telemetryBufferLimit;
+    }
+
+    uint32_t pending = this->telemetryMux.streams[HXRC_STREAM_DEFAULT].getPendingCount();
+    return pending >= size ? 100 : pending * 100 / size;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCBase::scheduleChannelSwitch( uint8_t channel, unsigned long delayMs )
+{
+    if ( channel == this->wifiChannel ) return;
+    this->channelSwitchMs = millis() + delayMs;
+    this->pendingChannel = channel;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCBase::updateChannelSwitch()
+{
+    unsigned long t = millis();
+
+    uint8_t channel = this->pendingChannel;
+    if ( ( channel != 0 ) && ( (long)( t - this->channelSwitchMs ) >= 0 ) )
+    {
+        this->pendingChannel = 0;
+        if ( HXRCSetWifiChannel( channel ) )
+        {
+            HXRCLOG.printf("HXRC: Switched to channel %d\n", channel);
+            this->prevChannel = this->wifiChannel;
+            this->wifiChannel = channel;
+            this->channelSwitchedMs = t;
+        }
+    }
+
+    if ( ( this->prevChannel != 0 ) && ( t - this->channelSwitchedMs > HXRC_CHANNEL_SWITCH_REVERT_MS ) )
+    {
+        //no packets received on new channel - peer did not follow
+        if ( (long)( this->receiverStats.lastReceivedTimeMs - this->channelSwitchedMs ) < 0 )
+        {
+            if ( HXRCSetWifiChannel( this->prevChannel ) )
+            {
+                HXRCLOG.printf("HXRC: No link, reverted to channel %d\n", this->prevChannel);
+                this->wifiChannel = this->prevChannel;
+            }
+        }
+        this->prevChannel = 0;
+    }
+}
@@ -9,6 +9,10 @@
 #include "HX_ESPNOW_RC_RingBuffer.h"
 #include "HX_ESPNOW_RC_TransmitterStats.h"
 #include "HX_ESPNOW_RC_ReceiverStats.h"
+#include "HX_ESPNOW_RC_TxPower.h"
+#include "HX_ESPNOW_RC_SendQueue.h"
+#include "HX_ESPNOW_RC_TelemetryMux.h"
+#include "HX_ESPNOW_RC_MavlinkFrameQueue.h"
 
 //=====================================================================
 //=====================================================================
@@ -38,12 +42,53 @@ protected:
     HXRCTransmitterStats transmitterStats;
     HXRCReceiverStats receiverStats;
 
+    HXRCTxPowerController txPowerController;
+
     uint8_t peerMac[6];
     
     volatile HXRCSenderStateEnum senderState;
+    //frames waiting for send callback
+    HXRCSendQueue sendQueue;
+
+    bool canSend() const;
+    //returns true if frame was accepted by esp_now_send()
+    bool sendFrame( uint16_t packetId, const uint8_t* data, size_t len, unsigned long t );
+    void onFrameSent( bool success );
 
+    //buffers of stream HXRC_STREAM_DEFAULT
     HXRCRingBuffer<HXRC_TELEMETRY_BUFFER_SIZE> incomingTelemetryBuffer;
     HXRCRingBuffer<HXRC_TELEMETRY_BUFFER_SIZE> outgoingTelemetryBuffer;
+    //replaces outgoingTelemetryBuffer if HXRCConfig::mavlinkFrameQueue is set
+    HXRCMavlinkFrameQueue outgoingMavlinkQueue;
+
+    HXRCRingBuffer<HXRC_CONTROL_STREAM_BUFFER_SIZE> incomingControlBuffer;
+    HXRCRingBuffer<HXRC_CONTROL_STREAM_BUFFER_SIZE> outgoingControlBuffer;
+
+    HXRCRingBuffer<HXRC_BULK_STREAM_BUFFER_SIZE> incomingBulkBuffer;
+    HXRCRingBuffer<HXRC_BULK_STREAM_BUFFER_SIZE> outgoingBulkBuffer;
+
+    HXRCTelemetryMux telemetryMux;
+
+    //used by stream HXRC_STREAM_DEFAULT
+    HXRCCompressor telemetryCompressor;
+    HXRCDecompressor telemetryDecompressor;
+
+    //fill data[] of outgoing payload from streams, length in *pLen.
+    //Returns false if telemetry is held by coalescing: nothing is filled, new sequenceId should not be used.
+    bool fillOutgoingTelemetry( uint8_t* data, uint8_t maxLen, unsigned long t, uint8_t* pLen );
+    //unpack data[] of incoming payload into streams. Called from wifi task.
+    void processIncomingTelemetry( const uint8_t* data, uint8_t len, uint16_t sequenceId );
+
+    uint8_t wifiChannel;
+    //channel switch scheduled at channelSwitchMs, 0 - none
+    volatile uint8_t pendingChannel;
+    volatile unsigned long channelSwitchMs;
+    //previous channel, to revert if link is not restored after switch
+    uint8_t prevChannel;
+    unsigned long channelSwitchedMs;
+
+    void scheduleChannelSwitch( uint8_t channel, unsigned long delayMs );
+    void updateChannelSwitch();
 
 public:
 
@@ -64,11 +109,28 @@ public:
     //we can send at most HXRC_MASTER_TELEMETRY_SIZE_MAX bytes every loop.
     bool sendOutgoingTelemetry( uint8_t* ptr, uint16_t size );
 
+    //same for specific stream HXRC_STREAM_xxx
+    uint16_t getIncomingTelemetry(uint8_t streamId, uint16_t maxSize, uint8_t* pBuffer);
+    bool sendOutgoingTelemetry( uint8_t streamId, uint8_t* ptr, uint16_t size );
+
+    //relative share of link bandwidth for streams DEFAULT and BULK. Stream CONTROL has strict priority.
+    void setStreamWeight( uint8_t streamId, uint8_t weight );
+    //0 - unlimited
+    void setStreamRateLimit( uint8_t streamId, uint16_t bytesPerSecond );
+
     HXRCTransmitterStats& getTransmitterStats();
     HXRCReceiverStats& getReceiverStats();
 
     void updateLed(int8_t ledPin, bool ledPinInverted);
 
     const uint8_t* getPeerMac() const;
+
+    uint8_t getWifiChannel() const;
+
+    //current TX power in dbm
+    uint8_t getTxPowerDbm() const;
+
+    //loop thread only. Fill of outgoing telemetry buffer (stream HXRC_STREAM_DEFAULT), 0..100%
+    uint8_t getOutgoingTelemetryBufferFill();
 };
 
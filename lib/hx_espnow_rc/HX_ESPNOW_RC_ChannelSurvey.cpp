@@ -0,0 +1,190 @@
+#include "HX_ESPNOW_RC_ChannelSurvey.h"
+#include "HX_ESPNOW_RC_Common.h"
+
+#if defined(ESP32)
+
+//wifi_phy_rate_t -> rate in 100kbit/s units. 0 - unknown.
+static const uint16_t RATE_100KBPS[32] =
+{
+    10, 20, 55, 110, 0, 20, 55, 110,            //DSSS/CCK long and short preamble
+    480, 240, 120, 60, 540, 360, 180, 90,       //OFDM
+    65, 130, 195, 260, 390, 520, 585, 650,      //HT20 MCS0-7 long GI
+    72, 144, 217, 289, 433, 578, 650, 722       //HT20 MCS0-7 short GI
+};
+
+//=====================================================================
+//=====================================================================
+HXRCChannelSurvey::HXRCChannelSurvey()
+{
+    this->subscriberId = -1;
+    this->running = false;
+    this->currentChannel = HXRC_SURVEY_CHANNEL_FIRST;
+    this->dwellMs = HXRC_SURVEY_DEFAULT_DWELL_MS;
+    memset( this->results, 0, sizeof(this->results) );
+}
+
+//=====================================================================
+//=====================================================================
+void ICACHE_RAM_ATTR HXRCChannelSurvey::onFrame( void* context, const wifi_promiscuous_pkt_t* ppkt, const wifi_ieee80211_mac_hdr_t* hdr )
+{
+    HXRCChannelSurvey* self = (HXRCChannelSurvey*)context;
+
+    uint8_t rate = ppkt->rx_ctrl.rate & 31;
+    uint32_t r = RATE_100KBPS[rate];
+    if ( r == 0 ) r = 10;
+
+    //preamble+PLCP header: 192us for long DSSS, 96us for short DSSS, ~20us for OFDM/HT
+    uint32_t preambleUs = rate < 4 ? 192 : ( rate < 8 ? 96 : 20 );
+
+    self->airtimeUs += preambleUs + ((uint32_t)ppkt->rx_ctrl.sig_len) * 80 / r;
+    self->noiseFloorSum += ppkt->rx_ctrl.noise_floor;
+    self->framesCount++;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCChannelSurvey::start( uint16_t dwellMs )
+{
+    this->dwellMs = dwellMs > 0 ? dwellMs : HXRC_SURVEY_DEFAULT_DWELL_MS;
+    memset( this->results, 0, sizeof(this->results) );
+
+    if ( this->subscriberId == -1 )
+    {
+        this->subscriberId = HXRCSniffer::instance.subscribe( NULL, HXRC_SNIFFER_SUBTYPE_ANY, &HXRCChannelSurvey::onFrame, this, false );
+        if ( this->subscriberId == -1 ) return;
+    }
+    HXRCSniffer::instance.start();
+
+    this->running = true;
+    startChannel( HXRC_SURVEY_CHANNEL_FIRST );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCChannelSurvey::startChannel( uint8_t channel )
+{
+    HXRCSniffer::instance.setEnabled( this->subscriberId, false );
+
+    this->currentChannel = channel;
+    esp_wifi_set_channel( channel, WIFI_SECOND_CHAN_NONE );
+
+    this->framesCount = 0;
+    this->airtimeUs = 0;
+    this->noiseFloorSum = 0;
+    this->channelStartMs = millis();
+
+    HXRCSniffer::instance.setEnabled( this->subscriberId, true );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCChannelSurvey::finishChannel( unsigned long t )
+{
+    HXRCSniffer::instance.setEnabled( this->subscriberId, false );
+
+    HXRCChannelSurveyResult& r = this->results[ this->currentChannel - HXRC_SURVEY_CHANNEL_FIRST ];
+    unsigned long dt = t - this->channelStartMs;
+    if ( dt == 0 ) dt = 1;
+
+    r.framesCount = this->framesCount;
+    r.airtimeUs = this->airtimeUs;
+    r.noiseFloor = r.framesCount > 0 ? this->noiseFloorSum / (int32_t)r.framesCount : 0;
+    uint32_t busy = r.airtimeUs / dt;   //us per ms = permille
+    r.busyPermille = busy > 1000 ? 1000 : busy;
+}
+
+//=====================================================================
+//=====================================================================
+//Adjacent 2.4Ghz channels overlap up to +-4 channels.
+//Channel score is weighted sum of own and neighbours load.
+void HXRCChannelSurvey::computeScores()
+{
+    uint32_t load[HXRC_SURVEY_CHANNELS_COUNT];
+
+    for ( int i = 0; i < HXRC_SURVEY_CHANNELS_COUNT; i++ )
+    {
+        const HXRCChannelSurveyResult& r = this->results[i];
+        uint32_t framesPerSecond = r.framesCount * 1000 / this->dwellMs;
+        //noise floor above -95dbm is penalized
+        uint32_t noisePenalty = ( r.framesCount > 0 && r.noiseFloor > -95 ) ? ( r.noiseFloor + 95 ) * 20 : 0;
+        load[i] = r.busyPermille * 4 + framesPerSecond + noisePenalty;
+    }
+
+    for ( int i = 0; i < HXRC_SURVEY_CHANNELS_COUNT; i++ )
+    {
+        uint32_t score = 0;
+        for ( int d = -4; d <= 4; d++ )
+        {
+            int j = i + d;
+            if ( j < 0 || j >= HXRC_SURVEY_CHANNELS_COUNT ) continue;
+            score += load[j] * ( 5 - abs(d) ) / 5;
+        }
+        this->results[i].score = score;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCChannelSurvey::loop()
+{
+    if ( !this->running ) return false;
+
+    unsigned long t = millis();
+    if ( t - this->channelStartMs < this->dwellMs ) return true;
+
+    finishChannel( t );
+
+    if ( this->currentChannel < HXRC_SURVEY_CHANNEL_LAST )
+    {
+        startChannel( this->currentChannel + 1 );
+        return true;
+    }
+
+    computeScores();
+    this->running = false;
+    return false;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCChannelSurvey::isRunning() const
+{
+    return this->running;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCChannelSurvey::getBestChannel() const
+{
+    int best = 0;
+    for ( int i = 1; i < HXRC_SURVEY_CHANNELS_COUNT; i++ )
+    {
+        if ( this->results[i].score < this->results[best].score ) best = i;
+    }
+    return best + HXRC_SURVEY_CHANNEL_FIRST;
+}
+
+//=====================================================================
+//=====================================================================
+const HXRCChannelSurveyResult& HXRCChannelSurvey::getResult( uint8_t channel ) const
+{
+    if ( channel < HXRC_SURVEY_CHANNEL_FIRST ) channel = HXRC_SURVEY_CHANNEL_FIRST;
+    if ( channel > HXRC_SURVEY_CHANNEL_LAST ) channel = HXRC_SURVEY_CHANNEL_LAST;
+    return this->results[ channel - HXRC_SURVEY_CHANNEL_FIRST ];
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCChannelSurvey::printResults()
+{
+    HXRCLOG.print("Channel survey:\n");
+    for ( int i = 0; i < HXRC_SURVEY_CHANNELS_COUNT; i++ )
+    {
+        const HXRCChannelSurveyResult& r = this->results[i];
+        HXRCLOG.printf(" Ch %2d | Frames: %u | Busy: %u%% | NF: %ddbm | Score: %u\n",
+            i + HXRC_SURVEY_CHANNEL_FIRST, r.framesCount, r.busyPermille / 10, r.noiseFloor, r.score );
+    }
+    HXRCLOG.printf(" Best channel: %d\n", getBestChannel() );
+}
+
+#endif
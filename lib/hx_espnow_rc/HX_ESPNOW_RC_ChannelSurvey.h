@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_Sniffer.h"
+
+#if defined(ESP32)
+
+#define HXRC_SURVEY_CHANNEL_FIRST       1
+#define HXRC_SURVEY_CHANNEL_LAST        13
+#define HXRC_SURVEY_CHANNELS_COUNT      (HXRC_SURVEY_CHANNEL_LAST - HXRC_SURVEY_CHANNEL_FIRST + 1)
+#define HXRC_SURVEY_DEFAULT_DWELL_MS    300
+
+//=====================================================================
+//=====================================================================
+typedef struct
+{
+    uint32_t framesCount;       //foreign frames seen while dwelling on channel
+    uint32_t airtimeUs;         //estimated airtime of these frames
+    int8_t noiseFloor;          //average noise floor in dbm, 0 if no frames received
+    uint16_t busyPermille;      //airtimeUs / dwell time
+    uint32_t score;             //lower is better; includes interference from overlapping channels
+} HXRCChannelSurveyResult;
+
+//=====================================================================
+//=====================================================================
+//Steps through channels 1..13, dwelling on each channel for configurable time.
+//Counts all frames via sniffer, estimates airtime from frame length and rate.
+//Driven from loop(); normal HXRC traffic should be paused while survey is running.
+class HXRCChannelSurvey
+{
+private:
+    volatile uint32_t framesCount;
+    volatile uint32_t airtimeUs;
+    volatile int32_t noiseFloorSum;
+
+    int subscriberId;
+    bool running;
+    uint8_t currentChannel;
+    uint16_t dwellMs;
+    unsigned long channelStartMs;
+
+    HXRCChannelSurveyResult results[HXRC_SURVEY_CHANNELS_COUNT];
+
+    static void ICACHE_RAM_ATTR onFrame( void* context, const wifi_promiscuous_pkt_t* ppkt, const wifi_ieee80211_mac_hdr_t* hdr );
+
+    void startChannel( uint8_t channel );
+    void finishChannel( unsigned long t );
+    void computeScores();
+
+public:
+    HXRCChannelSurvey();
+
+    //wifi_channel is restored by caller after survey is finished
+    void start( uint16_t dwellMs = HXRC_SURVEY_DEFAULT_DWELL_MS );
+    //returns true while survey is running
+    bool loop();
+
+    bool isRunning() const;
+
+    //valid after survey is finished
+    uint8_t getBestChannel() const;
+    const HXRCChannelSurveyResult& getResult( uint8_t channel ) const;
+
+    void printResults();
+};
+
+#endif
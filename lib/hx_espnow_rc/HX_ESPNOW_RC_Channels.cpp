@@ -5,6 +5,8 @@
 void HXRCChannels::init()
 {
     ch1 = ch2 = ch3 = ch4 = ch5 = ch6 = ch7 = ch8 = ch9 = ch10 = ch11 = ch12 = ch13 = ch14 = ch15 = ch16 = 1000;
+    ch17 = ch18 = 0;
+    reserved = 0;
 }
 
 //=====================================================================
@@ -45,6 +47,10 @@ uint16_t HXRCChannels::getChannelValue( uint8_t index ) const
             return ch15;
         case 15:
             return ch16;
+        case 16:
+            return ch17 == 1 ? 2000 : 1000;
+        case 17:
+            return ch18 == 1 ? 2000 : 1000;
         default:
             return 1000;
     }
@@ -104,5 +110,11 @@ void HXRCChannels::setChannelValue( uint8_t index, uint16_t data )
         case 15:
             ch16 = data;
             break;
+        case 16:
+            ch17 = data > 1500 ? 1 : 0;
+            break;
+        case 17:
+            ch18 = data > 1500 ? 1 : 0;
+            break;
     }
 }
@@ -27,6 +27,10 @@ typedef struct
     uint16_t ch15       : 11;
     uint16_t ch16       : 11;   //16*11 = 22 bytes
 
+    uint8_t ch17        : 1;    //digital channels
+    uint8_t ch18        : 1;
+    uint8_t reserved    : 6;
+
     void init();
     uint16_t getChannelValue( uint8_t index ) const;
     void setChannelValue(uint8_t index, uint16_t data);
@@ -41,30 +41,17 @@ void HXRCInitLedPin( const HXRCConfig& config )
 
 //=====================================================================
 //=====================================================================
-//https://esp32.com/viewtopic.php?t=13889
 #if defined(ESP32)
 HXRCPromiscuousCapture capture;
 
-static void ICACHE_RAM_ATTR sniffer_callback(void *buf, wifi_promiscuous_pkt_type_t type)
+//keeps last values of packets from peer; percentiles are computed from sniffer ring
+static void ICACHE_RAM_ATTR capture_callback(void* context, const wifi_promiscuous_pkt_t* ppkt, const wifi_ieee80211_mac_hdr_t* hdr)
 {
-    if  (type != WIFI_PKT_MGMT) return;
-
-    static const uint8_t ACTION_SUBTYPE = 0xd0;
-
-    const wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)buf;
-    const wifi_ieee80211_packet_t *ipkt = (wifi_ieee80211_packet_t *)ppkt->payload;
-    const wifi_ieee80211_mac_hdr_t *hdr = &ipkt->hdr;
-
-    if ( 
-        (ACTION_SUBTYPE == (hdr->frame_ctrl & 0xFF) ) &&
-        (memcmp( hdr->addr2, capture.peerMac, 6 ) == 0 )  //mac is first 6 digits
-    )
-    {
-        capture.rssi = ppkt->rx_ctrl.rssi;
-        capture.noiseFloor = ppkt->rx_ctrl.noise_floor;
-        capture.rate = ppkt->rx_ctrl.rate;
-        capture.packetsCount++;
-    }
+    HXRCPromiscuousCapture* pCapture = (HXRCPromiscuousCapture*)context;
+    pCapture->rssi = ppkt->rx_ctrl.rssi;
+    pCapture->noiseFloor = ppkt->rx_ctrl.noise_floor;
+    pCapture->rate = ppkt->rx_ctrl.rate;
+    pCapture->packetsCount++;
 }
 #endif
 
@@ -203,8 +190,11 @@ bool HXRCInitEspNow( HXRCConfig& config )
   }
 #endif
 
-    esp_wifi_set_promiscuous_rx_cb(&sniffer_callback);
-    esp_wifi_set_promiscuous(true); 
+    if ( capture.subscriberId == -1 )
+    {
+        capture.subscriberId = HXRCSniffer::instance.subscribe( capture.peerMac, HXRC_SNIFFER_SUBTYPE_ACTION, &capture_callback, &capture, true );
+    }
+    HXRCSniffer::instance.start();
 
     if (  esp_wifi_set_max_tx_power(84) != ESP_OK )
   {
@@ -215,6 +205,44 @@ bool HXRCInitEspNow( HXRCConfig& config )
     return true;
 }
 
+//=====================================================================
+//=====================================================================
+//change channel after HXRCInitEspNow()
+bool HXRCSetWifiChannel( uint8_t wifi_channel )
+{
+#if defined(ESP8266)
+    wifi_promiscuous_enable(true);
+    bool res = wifi_set_channel( wifi_channel );
+    wifi_promiscuous_enable(false);
+    if ( !res || esp_now_set_peer_channel( BROADCAST_MAC, wifi_channel ) != ESP_OK )
+    {
+        Serial.println("HXRC: Error: Failed to set channel");
+        return false;
+    }
+#elif defined(ESP32)
+    //promiscous mode is enabled by sniffer
+    if ( esp_wifi_set_channel( wifi_channel, WIFI_SECOND_CHAN_NONE) != ESP_OK )
+    {
+        Serial.println("HXRC: Error: Failed to set channel");
+        return false;
+    }
+
+    esp_now_peer_info_t peerInfo;
+    memcpy(peerInfo.peer_addr, BROADCAST_MAC, 6);
+    peerInfo.channel = wifi_channel;
+    memset(peerInfo.lmk, 0, ESP_NOW_KEY_LEN);
+    peerInfo.encrypt = false;
+    peerInfo.ifidx = WIFI_IF_STA;
+
+    if ( esp_now_mod_peer(&peerInfo) != ESP_OK )
+    {
+        Serial.println("HXRC: Error: Failed to modify peer");
+        return false;
+    }
+#endif
+    return true;
+}
+
 //=====================================================================
 //=====================================================================
 void HXRC_crc32_init()
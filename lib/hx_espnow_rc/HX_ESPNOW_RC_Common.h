@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #include "HX_ESPNOW_RC_PromiscuousCapture.h"
+#include "HX_ESPNOW_RC_Sniffer.h"
 
 #if defined(ESP8266)
 
@@ -33,12 +34,27 @@
 #define DEFAULT_FAILSAFE_PERIOD_MS      1000
 
 #define HXRC_CHANNELS_COUNT 16
+//SBUS ch17, ch18: index 16, 17, values 1000 or 2000
+#define HXRC_DIGITAL_CHANNELS_COUNT 2
 
 #define HXRC_TELEMETRY_BUFFER_SIZE   512
+#define HXRC_CONTROL_STREAM_BUFFER_SIZE   128
+#define HXRC_BULK_STREAM_BUFFER_SIZE   512
+
+//telemetry coalescing defaults: wait up to ? ms or until ? bytes before sending telemetry
+#define HXRC_TELEMETRY_COALESCE_MS_DEFAULT      0   //0 - disabled
+#define HXRC_TELEMETRY_COALESCE_BYTES_DEFAULT   32
+
+#define HXRC_INPUT_SYNC_MIN_INTERVAL_MS_DEFAULT 0   //0 - disabled
 
 #define HXRC_PAYLOAD_SIZE_MAX 250
 
-#define HXRC_PROTOCOL_VERSION 1
+#define HXRC_PROTOCOL_VERSION 6
+
+//channel switch is announced to slave this time in advance
+#define HXRC_CHANNEL_SWITCH_DELAY_MS    1000
+//return to previous channel if no packets are received after switch
+#define HXRC_CHANNEL_SWITCH_REVERT_MS   3000
 
 class HXRCConfig;
 
@@ -56,6 +72,7 @@ void HXRCSetLogStream( Stream* value );
 
 extern void HXRCInitLedPin( const HXRCConfig& config );
 extern bool HXRCInitEspNow( HXRCConfig& config );
+extern bool HXRCSetWifiChannel( uint8_t wifi_channel );
 
 extern void HXRC_crc32_init();
 extern uint32_t HXRC_crc32(const void* data, size_t length, uint32_t previousCrc32 = 0);
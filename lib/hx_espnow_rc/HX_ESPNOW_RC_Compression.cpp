@@ -0,0 +1,211 @@
+#include "HX_ESPNOW_RC_Compression.h"
+
+#define WINDOW_MASK (HXRC_COMPRESSION_WINDOW_SIZE - 1)
+
+//=====================================================================
+//=====================================================================
+static inline uint8_t hash3( const uint8_t* p )
+{
+    return ( (p[0] << 4) ^ (p[1] << 2) ^ p[2] ^ (p[2] >> 4) ) & (HXRC_COMPRESSION_HASH_SIZE - 1);
+}
+
+//=====================================================================
+//=====================================================================
+HXRCCompressor::HXRCCompressor()
+{
+    this->stagingCount = 0;
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCCompressor::reset()
+{
+    memset( this->hashHead, 0, sizeof(this->hashHead) );
+    this->pos = 0;
+}
+
+//=====================================================================
+//=====================================================================
+//append in[i] to window
+void HXRCCompressor::append( const uint8_t* in, uint16_t i, uint16_t inLen )
+{
+    if ( i + 2 < inLen )
+    {
+        this->hashHead[ hash3( &in[i] ) ] = this->pos + 1;
+    }
+    this->window[ this->pos & WINDOW_MASK ] = in[i];
+    this->pos++;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCCompressor::compress( const uint8_t* in, uint16_t inLen, uint8_t* out, uint16_t outMax, uint16_t* pConsumed )
+{
+    uint16_t o = 0;
+    uint16_t i = 0;
+    int litHeader = -1;
+
+    while ( i < inLen )
+    {
+        uint16_t matchLen = 0;
+        uint16_t distance = 0;
+
+        if ( inLen - i >= HXRC_COMPRESSION_MIN_MATCH )
+        {
+            uint32_t cand = this->hashHead[ hash3( &in[i] ) ];
+            if ( cand != 0 )
+            {
+                cand--;
+                uint32_t d = this->pos - cand;
+                if ( d >= 1 && d <= HXRC_COMPRESSION_WINDOW_SIZE )
+                {
+                    uint16_t maxLen = inLen - i;
+                    if ( maxLen > HXRC_COMPRESSION_MAX_MATCH ) maxLen = HXRC_COMPRESSION_MAX_MATCH;
+
+                    uint16_t l = 0;
+                    while ( l < maxLen )
+                    {
+                        uint32_t q = cand + l;
+                        //source can overlap with bytes being encoded
+                        uint8_t c = q < this->pos ? this->window[ q & WINDOW_MASK ] : in[ i + ( q - this->pos ) ];
+                        if ( c != in[i + l] ) break;
+                        l++;
+                    }
+
+                    if ( l >= HXRC_COMPRESSION_MIN_MATCH )
+                    {
+                        matchLen = l;
+                        distance = d;
+                    }
+                }
+            }
+        }
+
+        if ( matchLen > 0 )
+        {
+            if ( o + 2 > outMax ) break;
+            out[o++] = 0x80 | ( matchLen - HXRC_COMPRESSION_MIN_MATCH );
+            out[o++] = distance - 1;
+            litHeader = -1;
+
+            //window is updated after match is encoded: match source may overlap
+            while ( matchLen-- ) append( in, i++, inLen );
+        }
+        else
+        {
+            if ( ( litHeader >= 0 ) && ( out[litHeader] < HXRC_COMPRESSION_MAX_LITERALS - 1 ) )
+            {
+                if ( o + 1 > outMax ) break;
+                out[litHeader]++;
+            }
+            else
+            {
+                if ( o + 2 > outMax ) break;
+                litHeader = o;
+                out[o++] = 0;
+            }
+            out[o++] = in[i];
+            append( in, i++, inLen );
+        }
+    }
+
+    *pConsumed = i;
+    return o;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCCompressor::compressStaging( uint8_t* out, uint16_t outMax, uint16_t* pConsumed, bool* pCompressed )
+{
+    uint16_t len = compress( this->staging, this->stagingCount, out, outMax, pConsumed );
+
+    //incompressible data: raw bytes always fit, len >= *pConsumed
+    *pCompressed = len < *pConsumed;
+    if ( !*pCompressed )
+    {
+        len = *pConsumed;
+        memcpy( out, this->staging, len );
+    }
+
+    this->stagingCount -= *pConsumed;
+    if ( this->stagingCount > 0 )
+    {
+        memmove( this->staging, this->staging + *pConsumed, this->stagingCount );
+    }
+    return len;
+}
+
+//=====================================================================
+//=====================================================================
+HXRCDecompressor::HXRCDecompressor()
+{
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCDecompressor::reset()
+{
+    this->pos = 0;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCDecompressor::decompress( const uint8_t* in, uint16_t inLen, HXRCRingBufferInterface* pOut, bool* pOverflow )
+{
+    uint8_t buffer[64];
+    uint8_t count = 0;
+
+    uint16_t i = 0;
+    while ( i < inLen )
+    {
+        uint8_t c = in[i++];
+        uint16_t len;
+        uint32_t src = 0;
+        bool match = ( c & 0x80 ) != 0;
+
+        if ( match )
+        {
+            if ( i >= inLen ) return false;
+            len = ( c & 0x7F ) + HXRC_COMPRESSION_MIN_MATCH;
+            uint16_t distance = in[i++] + 1;
+            if ( distance > this->pos ) return false;  //reference before window start: out of sync
+            src = this->pos - distance;
+        }
+        else
+        {
+            len = c + 1;
+            if ( len > inLen - i ) return false;
+        }
+
+        while ( len-- )
+        {
+            uint8_t b = match ? this->window[ (src++) & WINDOW_MASK ] : in[i++];
+            this->window[ this->pos & WINDOW_MASK ] = b;
+            this->pos++;
+
+            buffer[count++] = b;
+            if ( count == sizeof(buffer) )
+            {
+                if ( !pOut->send( buffer, count ) ) *pOverflow = true;
+                count = 0;
+            }
+        }
+    }
+
+    if ( count > 0 && !pOut->send( buffer, count ) ) *pOverflow = true;
+
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCDecompressor::append( const uint8_t* in, uint16_t inLen )
+{
+    for ( uint16_t i = 0; i < inLen; i++ )
+    {
+        this->window[ this->pos & WINDOW_MASK ] = in[i];
+        this->pos++;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_RingBuffer.h"
+
+//LZSS-style streaming compression with small shared window.
+//Byte aligned tokens, so every chunk can be decoded on its own given window state:
+//0x00..0x7F: literal run of (c+1) bytes follows
+//0x80..0xFF: match of (c & 0x7F) + 3 bytes, followed by 1 byte (distance - 1)
+#define HXRC_COMPRESSION_WINDOW_SIZE    256     //power of 2, distance fits in 1 byte
+#define HXRC_COMPRESSION_HASH_SIZE      64      //power of 2
+#define HXRC_COMPRESSION_STAGING_SIZE   128
+#define HXRC_COMPRESSION_MIN_MATCH      3
+#define HXRC_COMPRESSION_MAX_MATCH      130
+#define HXRC_COMPRESSION_MAX_LITERALS   128
+
+//compressor resets window periodically so receiver can resync after loss
+#define HXRC_COMPRESSION_RESYNC_MS      1000
+
+//=====================================================================
+//=====================================================================
+class HXRCCompressor
+{
+private:
+    uint8_t window[HXRC_COMPRESSION_WINDOW_SIZE];
+    //absolute position + 1 of last occurrence of 3-byte hash, 0 - none
+    uint32_t hashHead[HXRC_COMPRESSION_HASH_SIZE];
+    uint32_t pos;
+
+    void append( const uint8_t* in, uint16_t i, uint16_t inLen );
+
+public:
+    //raw data waiting for compression
+    uint8_t staging[HXRC_COMPRESSION_STAGING_SIZE];
+    uint16_t stagingCount;
+
+    HXRCCompressor();
+
+    void reset();
+
+    //compress as much of in[] as fits into outMax bytes.
+    //returns output length, *pConsumed is number of input bytes consumed.
+    uint16_t compress( const uint8_t* in, uint16_t inLen, uint8_t* out, uint16_t outMax, uint16_t* pConsumed );
+
+    //compress staging buffer, remove consumed bytes.
+    //If compressed data is not smaller than consumed bytes, out[] receives consumed bytes as is and *pCompressed is false.
+    //Window advances over consumed bytes in both cases.
+    uint16_t compressStaging( uint8_t* out, uint16_t outMax, uint16_t* pConsumed, bool* pCompressed );
+};
+
+//=====================================================================
+//=====================================================================
+class HXRCDecompressor
+{
+private:
+    uint8_t window[HXRC_COMPRESSION_WINDOW_SIZE];
+    uint32_t pos;
+
+public:
+    HXRCDecompressor();
+
+    void reset();
+
+    //decompress chunk into ring buffer
+    //returns false on malformed data (out of sync). *pOverflow is set if pOut is overflown (window stays in sync).
+    bool decompress( const uint8_t* in, uint16_t inLen, HXRCRingBufferInterface* pOut, bool* pOverflow );
+
+    //advance window over uncompressed chunk of compressed stream
+    void append( const uint8_t* in, uint16_t inLen );
+};
@@ -5,11 +5,7 @@
 //=====================================================================
 HXRCConfig::HXRCConfig()
 {
-    this->wifi_channel = 1;
-    this->key = 0;
-    this->LRMode = false;
-    this->ledPin = -1;
-    this->ledPinInverted = false;
+    this->initDefaults();
 }
 
 //=====================================================================
@@ -22,10 +18,50 @@ HXRCConfig::HXRCConfig(
         bool ledPinInverted
     )
 {
+    this->initDefaults();
+
     this->wifi_channel = wifi_channel;
     this->key = key;
     this->LRMode = LRMode;
     this->ledPin = ledPin;
-    this-> ledPinInverted = ledPinInverted;
+    this->ledPinInverted = ledPinInverted;
 }
 
+//=====================================================================
+//=====================================================================
+void HXRCConfig::initDefaults()
+{
+    this->wifi_channel = 1;
+    this->key = 0;
+    this->LRMode = false;
+    this->ledPin = -1;
+    this->ledPinInverted = false;
+    this->adaptiveTxPower = true;
+    this->packetPeriodMs = 0;
+    this->failsafePeriodMs = DEFAULT_FAILSAFE_PERIOD_MS;
+    this->signalHoldFrames = HXRC_SIGNAL_HOLD_FRAMES_DEFAULT;
+    this->failsafeFrames = HXRC_FAILSAFE_FRAMES_DEFAULT;
+    this->telemetryBufferLimit = HXRC_TELEMETRY_BUFFER_SIZE;
+    this->telemetrySizeMax = 0;
+    this->telemetryCompression = false;
+    this->mavlinkFrameQueue = false;
+    this->mavlinkFrameQueueValidatedInput = false;
+    this->telemetryCoalesceMs = HXRC_TELEMETRY_COALESCE_MS_DEFAULT;
+    this->telemetryCoalesceBytes = HXRC_TELEMETRY_COALESCE_BYTES_DEFAULT;
+    this->inputSyncMinIntervalMs = HXRC_INPUT_SYNC_MIN_INTERVAL_MS_DEFAULT;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCConfig::getPacketPeriodMs() const
+{
+    if ( this->packetPeriodMs > 0 ) return this->packetPeriodMs;
+    return this->LRMode ? DEFAULT_PACKET_SEND_PERIOD_LR_MS : DEFAULT_PACKET_SEND_PERIOD_MS;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCConfig::getTelemetrySizeMax( uint8_t v ) const
+{
+    return ( this->telemetrySizeMax > 0 && this->telemetrySizeMax < v ) ? this->telemetrySizeMax : v;
+}
@@ -4,17 +4,52 @@
 #include <stdint.h>
 
 #include "HX_ESPNOW_RC_Common.h"
+#include "HX_ESPNOW_RC_LinkState.h"
 
 //=====================================================================
 //=====================================================================
 class HXRCConfig
 {
+private:
+    //defaults of all fields, shared by constructors
+    void initDefaults();
+
 public:
     uint8_t wifi_channel;
     bool LRMode;
     int8_t ledPin;
     bool ledPinInverted;
     uint16_t key;
+    //adjust TX power from RSSI reported by peer
+    bool adaptiveTxPower;
+
+    //master packet period, ms. 0 - DEFAULT_PACKET_SEND_PERIOD_MS or DEFAULT_PACKET_SEND_PERIOD_LR_MS depending on LRMode
+    uint16_t packetPeriodMs;
+    //no packets/acknowledges for this time means failsafe
+    uint16_t failsafePeriodMs;
+    //consecutive missed frames to report signal hold/failsafe. 0 - disabled.
+    uint16_t signalHoldFrames;
+    uint16_t failsafeFrames;
+    //max number of bytes waiting in outgoing telemetry buffer, up to HXRC_TELEMETRY_BUFFER_SIZE.
+    //Smaller value means lower latency when link is saturated.
+    uint16_t telemetryBufferLimit;
+    //max telemetry bytes in outgoing packet, up to HXRC_MASTER_TELEMETRY_SIZE_MAX/HXRC_SLAVE_TELEMETRY_SIZE_MAX.
+    //0 - max. Smaller packets have better chances of successfull delivery.
+    uint8_t telemetrySizeMax;
+    //compress outgoing telemetry of default stream
+    bool telemetryCompression;
+    //outgoing telemetry of default stream is MAVLink: send whole frames, drop whole frames on overflow
+    bool mavlinkFrameQueue;
+    //outgoing telemetry is written as whole frames already validated by HXRCMavlinkStreamFilter:
+    //frame queue splits frames by header length without checking CRC again
+    bool mavlinkFrameQueueValidatedInput;
+    //Nagle-style coalescing: hold outgoing telemetry until coalesceBytes are available 
+    //or oldest byte waits coalesceMs. Control stream is never held. 0 ms - disabled.
+    uint16_t telemetryCoalesceMs;
+    uint16_t telemetryCoalesceBytes;
+    //Master: send packet on input frame event (HXRCMaster::onInputFrame()), but not earlier than 
+    //inputSyncMinIntervalMs after previous packet. Packets are still sent with packet period if there are no events. 0 - disabled.
+    uint16_t inputSyncMinIntervalMs;
 
     HXRCConfig();
 
@@ -25,5 +60,9 @@ public:
         int8_t ledPin,
         bool ledPinInverted
     );
-    
+
+    uint16_t getPacketPeriodMs() const;
+    //limit v by telemetrySizeMax
+    uint8_t getTelemetrySizeMax( uint8_t v ) const;
+
 };
@@ -0,0 +1,120 @@
+#include "HX_ESPNOW_RC_LinkState.h"
+
+//=====================================================================
+//=====================================================================
+HXRCLinkState::HXRCLinkState()
+{
+    init( HXRC_SIGNAL_HOLD_FRAMES_DEFAULT, HXRC_FAILSAFE_FRAMES_DEFAULT, DEFAULT_FAILSAFE_PERIOD_MS );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCLinkState::init( uint16_t holdFrames, uint16_t failsafeFrames, unsigned long failsafePeriodMs )
+{
+    this->holdFrames = holdFrames;
+    this->failsafeFrames = failsafeFrames;
+    this->failsafePeriodMs = failsafePeriodMs;
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCLinkState::reset()
+{
+    unsigned long t = millis();
+
+    this->state = HXRC_LINK_STATE_FAILSAFE;
+    this->connected = false;
+    this->outageStartMs = t;
+    this->failsafeStartMs = t;
+
+    this->holdEvents = 0;
+    this->failsafeEvents = 0;
+    memset( this->holdHistogram, 0, sizeof(this->holdHistogram) );
+    memset( this->failsafeHistogram, 0, sizeof(this->failsafeHistogram) );
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCLinkState::getBucket( uint32_t frames )
+{
+    uint8_t b = 0;
+    while ( ( frames > 1 ) && ( b < HXRC_LINK_HISTOGRAM_SIZE - 1 ) )
+    {
+        frames >>= 1;
+        b++;
+    }
+    return b;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCLinkState::getState( unsigned long msSinceLastPacket, uint16_t periodMs ) const
+{
+    if ( msSinceLastPacket >= this->failsafePeriodMs ) return HXRC_LINK_STATE_FAILSAFE;
+
+    //frame is missed if it is not received within one period after expected time
+    uint32_t missed = periodMs > 0 ? msSinceLastPacket / periodMs : 0;
+    if ( missed > 0 ) missed--;
+
+    if ( ( this->failsafeFrames > 0 ) && ( missed >= this->failsafeFrames ) ) return HXRC_LINK_STATE_FAILSAFE;
+    if ( ( this->holdFrames > 0 ) && ( missed >= this->holdFrames ) ) return HXRC_LINK_STATE_HOLD;
+    return HXRC_LINK_STATE_OK;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCLinkState::update( unsigned long msSinceLastPacket, uint16_t periodMs )
+{
+    uint8_t newState = getState( msSinceLastPacket, periodMs );
+    if ( newState == this->state ) return;
+
+    unsigned long t = millis();
+    if ( periodMs == 0 ) periodMs = 1;
+
+    if ( this->state == HXRC_LINK_STATE_OK )
+    {
+        this->holdEvents++;
+        this->outageStartMs = t - msSinceLastPacket;
+    }
+
+    if ( newState == HXRC_LINK_STATE_FAILSAFE )
+    {
+        this->failsafeEvents++;
+        this->failsafeStartMs = t;
+    }
+    else if ( newState == HXRC_LINK_STATE_OK )
+    {
+        //initial failsafe before first connection is not counted
+        if ( this->connected )
+        {
+            this->holdHistogram[ getBucket( ( t - this->outageStartMs ) / periodMs ) ]++;
+            if ( this->state == HXRC_LINK_STATE_FAILSAFE )
+            {
+                this->failsafeHistogram[ getBucket( ( t - this->failsafeStartMs ) / periodMs ) ]++;
+            }
+        }
+        this->connected = true;
+    }
+
+    this->state = newState;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCLinkState::printStats()
+{
+    HXRCLOG.printf(" Hold: %u", this->holdEvents);
+    HXRCLOG.printf(" | FS: %u", this->failsafeEvents);
+    HXRCLOG.print(" | Hold frames:");
+    for ( int i = 0; i < HXRC_LINK_HISTOGRAM_SIZE; i++ )
+    {
+        if ( this->holdHistogram[i] > 0 ) HXRCLOG.printf(" %u:%u", 1 << i, this->holdHistogram[i]);
+    }
+    HXRCLOG.print(" | FS frames:");
+    for ( int i = 0; i < HXRC_LINK_HISTOGRAM_SIZE; i++ )
+    {
+        if ( this->failsafeHistogram[i] > 0 ) HXRCLOG.printf(" %u:%u", 1 << i, this->failsafeHistogram[i]);
+    }
+    HXRCLOG.print("\n");
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_Common.h"
+
+#define HXRC_LINK_STATE_OK          0
+#define HXRC_LINK_STATE_HOLD        1   //few frames missed, keep last values
+#define HXRC_LINK_STATE_FAILSAFE    2
+
+#define HXRC_SIGNAL_HOLD_FRAMES_DEFAULT     3
+#define HXRC_FAILSAFE_FRAMES_DEFAULT        50
+
+//log2 buckets of outage duration in frames: 1, 2-3, 4-7 ... 2048+
+#define HXRC_LINK_HISTOGRAM_SIZE    12
+
+//=====================================================================
+//=====================================================================
+//Signal hold and failsafe detection based on number of consecutive missed frames at known packet rate.
+//Failsafe is also reported after failsafePeriodMs regardless of packet rate.
+class HXRCLinkState
+{
+private:
+    uint16_t holdFrames;
+    uint16_t failsafeFrames;
+    unsigned long failsafePeriodMs;
+
+    uint8_t state;
+    bool connected;
+    unsigned long outageStartMs;
+    unsigned long failsafeStartMs;
+
+    static uint8_t getBucket( uint32_t frames );
+
+public:
+    uint16_t holdEvents;
+    uint16_t failsafeEvents;
+    //duration of outages (hold, including failsafe part) and failsafe states, in frames
+    uint16_t holdHistogram[HXRC_LINK_HISTOGRAM_SIZE];
+    uint16_t failsafeHistogram[HXRC_LINK_HISTOGRAM_SIZE];
+
+    HXRCLinkState();
+
+    //holdFrames/failsafeFrames = 0 - disabled
+    void init( uint16_t holdFrames, uint16_t failsafeFrames, unsigned long failsafePeriodMs );
+    void reset();
+
+    uint8_t getState( unsigned long msSinceLastPacket, uint16_t periodMs ) const;
+
+    //called from loop() to track state transitions
+    void update( unsigned long msSinceLastPacket, uint16_t periodMs );
+
+    void printStats();
+};
@@ -32,11 +32,7 @@ void HXRCMaster::OnDataSent(uint8_t *mac_addr, uint8_t status)
 void HXRCMaster::OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status)
 #endif
 {
-    if( status != ESP_NOW_SEND_SUCCESS )
-    {
-        transmitterStats.onPacketSendError();
-    }
-    senderState = HXRCSS_READY_TO_SEND;
+    onFrameSent( status == ESP_NOW_SEND_SUCCESS );
 }
 
 //=====================================================================
@@ -70,10 +66,7 @@ void HXRCMaster::OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int
 
             if ( receiverStats.onPacketReceived( pPayload->packetId, pPayload->sequenceId, pPayload->length, pPayload->RSSIDbm, pPayload->NoiseFloor ) )
             {
-                if ( !this->incomingTelemetryBuffer.send( pPayload->data, pPayload->length ) )
-                {
-                    receiverStats.onTelemetryOverflow();
-                }
+                processIncomingTelemetry( pPayload->data, pPayload->length, pPayload->sequenceId );
             }
             this->receivedSequenceId = pPayload->sequenceId;
 
@@ -118,6 +111,12 @@ bool HXRCMaster::init( HXRCConfig config )
     esp_now_register_recv_cb(OnDataRecvStatic);
 
     this->lastReceived = 0;
+    this->sendBlocked = false;
+    this->inputFramePending = false;
+
+#if defined(ESP32)
+    this->channelSurveyMoveSlave = false;
+#endif
 
     return true;
 }
@@ -126,20 +125,61 @@ bool HXRCMaster::init( HXRCConfig config )
 //=====================================================================
 void HXRCMaster::loop()
 {
-    if ( senderState == HXRCSS_READY_TO_SEND )
+#if defined(ESP32)
+    if ( this->channelSurvey.isRunning() )
+    {
+        if ( !this->channelSurvey.loop() )
+        {
+            onChannelSurveyFinished();
+        }
+        HXRCBase::loop();
+        return;
+    }
+
+    if ( this->channelSurveyMoveSlave && !this->receiverStats.isFailsafe() )
+    {
+        this->channelSurveyMoveSlave = false;
+        scheduleChannelSwitch( this->channelSurvey.getBestChannel(), HXRC_CHANNEL_SWITCH_DELAY_MS );
+    }
+#endif
+
+    if ( senderState != HXRCSS_INIT )
     {
         unsigned long t = millis();
         unsigned long deltaT = t - transmitterStats.lastSendTimeMs;
 
-        int count = deltaT / (this->config.LRMode ? DEFAULT_PACKET_SEND_PERIOD_LR_MS : DEFAULT_PACKET_SEND_PERIOD_MS);
-        if ( count > 1)
+        int count = deltaT / this->config.getPacketPeriodMs();
+        bool inputSync = false;
+
+        if ( ( count == 0 ) && this->inputFramePending && ( this->config.inputSyncMinIntervalMs > 0 ) && ( deltaT >= this->config.inputSyncMinIntervalMs ) )
         {
-            outgoingData.packetId += count - 1;  //missed time to send packet(s) with desired rate
-            transmitterStats.onPacketSendMiss( count - 1 );           
+            //send in phase with input frames
+            count = 1;
+            inputSync = true;
         }
 
-        if ( count > 0 )
+        if ( ( count > 0 ) && !canSend() )
+        {
+            //frame is due, but send queue is full. Hold it until slot is free.
+            //Frame is built at send time, so it will carry fresh channels values.
+            this->sendBlocked = true;
+        }
+        else if ( count > 0 )
         {
+            if ( inputSync ) transmitterStats.packetsInputSync++;
+
+            if ( count > 1)
+            {
+                outgoingData.packetId += count - 1;  //missed time to send packet(s) with desired rate
+                transmitterStats.onPacketSendMiss( count - 1 );           
+                if ( this->sendBlocked )
+                {
+                    //held frame was replaced by newer one
+                    transmitterStats.onPacketSuperseded( count - 1 );
+                }
+            }
+            this->sendBlocked = false;
+
             outgoingData.packetId++;
 
             //always send fresh channels values
@@ -147,25 +187,40 @@ void HXRCMaster::loop()
 
             if ( !this->waitAck )
             {
-                outgoingData.sequenceId++;
-                outgoingData.length = outgoingTelemetryBuffer.receiveUpTo( HXRC_MASTER_TELEMETRY_SIZE_MAX, outgoingData.data );
-                this->waitAck = true;
+                //on coalescing hold, send packet without telemetry under the same sequenceId:
+                //receiver ignores it as a duplicate, ack field is still delivered
+                if ( fillOutgoingTelemetry( outgoingData.data, this->config.getTelemetrySizeMax( HXRC_MASTER_TELEMETRY_SIZE_MAX ), t, &outgoingData.length ) )
+                {
+                    outgoingData.sequenceId++;
+                    this->waitAck = true;
+                }
             }
 
             outgoingData.ackSequenceId = receivedSequenceId;
+            outgoingData.RSSIDbm = this->transmitterStats.getRSSIDbm();
 
-            outgoingData.setCRC();
-            transmitterStats.onPacketSend( t );
-            esp_err_t result = esp_now_send(BROADCAST_MAC, (uint8_t *) &outgoingData, HXRC_MASTER_PAYLOAD_SIZE_BASE + outgoingData.length );
-            //esp_err_t result = esp_now_send(NULL, (uint8_t *) &outgoingData, HXRC_MASTER_PAYLOAD_SIZE_BASE + outgoingData.length );
-            if (result == ESP_OK) 
+            if ( this->pendingChannel != 0 )
             {
-                senderState = HXRCSS_WAIT_SEND_FINISH;
+                long dt = this->channelSwitchMs - t;
+                dt = dt < 0 ? 0 : dt / 10;
+                outgoingData.nextChannel = this->pendingChannel;
+                outgoingData.channelSwitchTime10ms = dt > 255 ? 255 : dt;
             }
             else
             {
-                Serial.println(result);
-            }            
+                outgoingData.nextChannel = 0;
+                outgoingData.channelSwitchTime10ms = 0;
+            }
+
+            outgoingData.setCRC();
+            transmitterStats.onPacketSend( t );
+            sendFrame( outgoingData.packetId, (uint8_t *) &outgoingData, HXRC_MASTER_PAYLOAD_SIZE_BASE + outgoingData.length, t );
+
+            if ( this->inputFramePending )
+            {
+                this->inputFramePending = false;
+                transmitterStats.onInputFrameSent( micros() - this->inputFrameTimeUs );
+            }
         }
 
     }
@@ -180,6 +235,20 @@ void HXRCMaster::setChannelValue(uint8_t index, uint16_t data)
     this->channels.setChannelValue( index, data );
 }
 
+//=====================================================================
+//=====================================================================
+void HXRCMaster::onInputFrame( unsigned long timeUs )
+{
+    if ( this->inputFramePending )
+    {
+        //previous frame was not sent yet. Latency is measured from oldest frame.
+        transmitterStats.inputFramesSuperseded++;
+        return;
+    }
+    this->inputFramePending = true;
+    this->inputFrameTimeUs = timeUs;
+}
+
 //=====================================================================
 //=====================================================================
 uint32_t HXRCMaster::getA1()
@@ -194,4 +263,40 @@ uint32_t HXRCMaster::getA2()
     return this->A2;
 }
 
+#if defined(ESP32)
+//=====================================================================
+//=====================================================================
+void HXRCMaster::startChannelSurvey( uint16_t dwellMs, bool moveSlave )
+{
+    this->channelSurveyMoveSlave = false;
+    this->pendingChannel = 0;
+    this->channelSurvey.start( dwellMs );
+    this->channelSurveyMoveSlave = moveSlave && this->channelSurvey.isRunning();
+}
 
+//=====================================================================
+//=====================================================================
+bool HXRCMaster::isChannelSurveyRunning() const
+{
+    return this->channelSurvey.isRunning();
+}
+
+//=====================================================================
+//=====================================================================
+HXRCChannelSurvey& HXRCMaster::getChannelSurvey()
+{
+    return this->channelSurvey;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMaster::onChannelSurveyFinished()
+{
+    this->channelSurvey.printResults();
+
+    HXRCSetWifiChannel( this->wifiChannel );
+
+    //do not count time spent in survey as missed packets
+    this->transmitterStats.lastSendTimeMs = millis();
+}
+#endif
@@ -3,6 +3,7 @@
 #include <Arduino.h>
 
 #include "HX_ESPNOW_RC_Base.h"
+#include "HX_ESPNOW_RC_ChannelSurvey.h"
 
 //=====================================================================
 //=====================================================================
@@ -11,12 +12,26 @@ class HXRCMaster : public HXRCBase
 private:
     //when last packet received
     unsigned long lastReceived;
+
+    //frame was due while send queue was full
+    bool sendBlocked;
+
+    //input frame was received and is waiting to be sent
+    bool inputFramePending;
+    unsigned long inputFrameTimeUs;
     
     static HXRCMaster* pInstance;
 
     HXRCMasterPayload outgoingData;
     HXRCChannels channels;
 
+#if defined(ESP32)
+    HXRCChannelSurvey channelSurvey;
+    //move slave to the best channel when link is restored after survey
+    bool channelSurveyMoveSlave;
+    void onChannelSurveyFinished();
+#endif
+
 #if defined(ESP8266)
     static void OnDataSentStatic(uint8_t *mac_addr, uint8_t status);
     static void OnDataRecvStatic(uint8_t *mac, uint8_t *incomingData, uint8_t len);
@@ -41,7 +56,19 @@ public:
     //data = 1000...2000
     void setChannelValue( uint8_t index, uint16_t data);
 
+    //new input frame (ex. SBUS) with channel values was received at timeUs (micros()).
+    //Used to measure input to air latency. If config.inputSyncMinIntervalMs > 0, packet is sent on next loop().
+    void onInputFrame( unsigned long timeUs );
+
     uint32_t getA1();
     uint32_t getA2();
+
+#if defined(ESP32)
+    //Pause link and survey channels 1..13. Return to current channel after survey.
+    //If moveSlave is true, both peers switch to the best channel after link is restored.
+    void startChannelSurvey( uint16_t dwellMs, bool moveSlave );
+    bool isChannelSurveyRunning() const;
+    HXRCChannelSurvey& getChannelSurvey();
+#endif
 };
 
@@ -3,7 +3,7 @@
 #include "HX_ESPNOW_RC_Common.h"
 #include "HX_ESPNOW_RC_Channels.h"
 
-#define HXRC_MASTER_PAYLOAD_SIZE_BASE (4 + 2 + 2 + 2 + 2 + 22 + 1 )  
+#define HXRC_MASTER_PAYLOAD_SIZE_BASE (4 + 2 + 2 + 2 + 2 + 1 + 1 + 1 + 23 + 1 )  
 //#define HXRC_MASTER_TELEMETRY_SIZE_MAX ( HXRC_PAYLOAD_SIZE_MAX - HXRC_MASTER_PAYLOAD_SIZE_BASE )
 #define HXRC_MASTER_TELEMETRY_SIZE_MAX 64  //limit packet size to improve chances of successfull delivery
 
@@ -35,6 +35,14 @@ typedef struct
     //acknowledge of last incoming packet
     uint16_t ackSequenceId;
 
+    //channel switch announcement, 0 - no switch is scheduled
+    uint8_t nextChannel;
+    //time until channel switch, in 10ms units
+    uint8_t channelSwitchTime10ms;
+
+    //RSSI of slave packets on master, positive value in dbm, 0 - unknown
+    uint8_t RSSIDbm;
+
     HXRCChannels channels;
 
     uint8_t length;
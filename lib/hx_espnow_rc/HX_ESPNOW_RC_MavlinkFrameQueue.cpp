@@ -0,0 +1,290 @@
+#include "HX_ESPNOW_RC_MavlinkFrameQueue.h"
+
+//=====================================================================
+//=====================================================================
+HXRCMavlinkFrameQueue::HXRCMavlinkFrameQueue()
+{
+    this->parser.setPassUnknownMessages( true );
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkFrameQueue::reset()
+{
+    this->bufferCount = 0;
+    this->framesCount = 0;
+    this->headSent = 0;
+
+    this->tailCount = 0;
+    this->parser.init();
+
+    this->droppedBytesTotal = 0;
+
+    this->framesQueued = 0;
+    this->framesDropped = 0;
+    this->framesDeduplicated = 0;
+    this->garbageBytes = 0;
+    this->crcErrors = 0;
+    this->unknownFrames = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkFrameQueue::setValidatedInput( bool validated )
+{
+    this->parser.setVerifyCRC( !validated );
+}
+
+//=====================================================================
+//=====================================================================
+//messages which should not be lost or replaced
+bool HXRCMavlinkFrameQueue::isPriorityMessage( uint32_t msgId )
+{
+    switch ( msgId )
+    {
+        case 0:     //HEARTBEAT
+        case 11:    //SET_MODE
+        case 20:    //PARAM_REQUEST_READ
+        case 21:    //PARAM_REQUEST_LIST
+        case 22:    //PARAM_VALUE
+        case 23:    //PARAM_SET
+        case 75:    //COMMAND_INT
+        case 76:    //COMMAND_LONG
+        case 77:    //COMMAND_ACK
+        case 253:   //STATUSTEXT
+            return true;
+    }
+
+    //MISSION_xxx
+    return ( ( msgId >= 37 ) && ( msgId <= 51 ) ) || ( msgId == 73 );
+}
+
+//=====================================================================
+//=====================================================================
+//periodic telemetry: only the latest message is useful
+bool HXRCMavlinkFrameQueue::isStreamMessage( uint32_t msgId )
+{
+    switch ( msgId )
+    {
+        case 1:     //SYS_STATUS
+        case 2:     //SYSTEM_TIME
+        case 24:    //GPS_RAW_INT
+        case 26:    //SCALED_IMU
+        case 27:    //RAW_IMU
+        case 29:    //SCALED_PRESSURE
+        case 30:    //ATTITUDE
+        case 31:    //ATTITUDE_QUATERNION
+        case 32:    //LOCAL_POSITION_NED
+        case 33:    //GLOBAL_POSITION_INT
+        case 34:    //RC_CHANNELS_SCALED
+        case 35:    //RC_CHANNELS_RAW
+        case 36:    //SERVO_OUTPUT_RAW
+        case 62:    //NAV_CONTROLLER_OUTPUT
+        case 65:    //RC_CHANNELS
+        case 74:    //VFR_HUD
+        case 109:   //RADIO_STATUS
+        case 116:   //SCALED_IMU2
+        case 124:   //GPS2_RAW
+        case 125:   //POWER_STATUS
+        case 129:   //SCALED_IMU3
+        case 136:   //TERRAIN_REPORT
+        case 137:   //SCALED_PRESSURE2
+        case 141:   //ALTITUDE
+        case 147:   //BATTERY_STATUS
+        case 152:   //MEMINFO
+        case 163:   //AHRS
+        case 165:   //HWSTATUS
+        case 168:   //WIND
+        case 173:   //RANGEFINDER
+        case 178:   //AHRS2
+        case 193:   //EKF_STATUS_REPORT
+        case 230:   //ESTIMATOR_STATUS
+        case 241:   //VIBRATION
+        case 245:   //EXTENDED_SYS_STATE
+            return true;
+    }
+    return false;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCMavlinkFrameQueue::getFrameOffset( uint8_t index )
+{
+    uint16_t offset = 0;
+    for ( uint8_t i = 0; i < index; i++ ) offset += this->frames[i].length;
+    return offset;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkFrameQueue::removeFrame( uint8_t index )
+{
+    uint16_t offset = getFrameOffset( index );
+    uint16_t length = this->frames[index].length;
+
+    memmove( this->buffer + offset, this->buffer + offset + length, this->bufferCount - offset - length );
+    this->bufferCount -= length;
+
+    this->framesCount--;
+    for ( uint8_t i = index; i < this->framesCount; i++ ) this->frames[i] = this->frames[i+1];
+}
+
+//=====================================================================
+//=====================================================================
+//drop oldest frame of the lowest class up to maxClass. Partially sent frame is never dropped.
+bool HXRCMavlinkFrameQueue::dropFrame( uint8_t maxClass )
+{
+    for ( uint8_t frameClass = HXRC_MAVLINK_FRAME_STREAM; frameClass <= maxClass; frameClass++ )
+    {
+        for ( uint8_t i = this->headSent > 0 ? 1 : 0; i < this->framesCount; i++ )
+        {
+            if ( this->frames[i].frameClass == frameClass )
+            {
+                this->droppedBytesTotal += this->frames[i].length;
+                this->framesDropped++;
+                removeFrame( i );
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkFrameQueue::enqueueFrame( const HXMavlinkFrameView& view )
+{
+    HXRCMavlinkFrameInfo info;
+    info.length = view.getLength();
+    info.sysId = view.sysId;
+    info.compId = view.compId;
+    info.msgId = view.msgId;
+    //message id of unknown frame may be corrupted, it is not prioritized or deduplicated
+    info.frameClass = !view.known ? HXRC_MAVLINK_FRAME_NORMAL :
+        isPriorityMessage( info.msgId ) ? HXRC_MAVLINK_FRAME_PRIORITY :
+        isStreamMessage( info.msgId ) ? HXRC_MAVLINK_FRAME_STREAM : HXRC_MAVLINK_FRAME_NORMAL;
+
+    //keep only latest stream message
+    if ( info.frameClass == HXRC_MAVLINK_FRAME_STREAM )
+    {
+        for ( uint8_t i = this->headSent > 0 ? 1 : 0; i < this->framesCount; i++ )
+        {
+            const HXRCMavlinkFrameInfo& f = this->frames[i];
+            if ( ( f.msgId == info.msgId ) && ( f.sysId == info.sysId ) && ( f.compId == info.compId ) )
+            {
+                this->droppedBytesTotal += f.length;
+                this->framesDeduplicated++;
+                removeFrame( i );
+                break;
+            }
+        }
+    }
+
+    while ( ( this->bufferCount + info.length > HXRC_MAVLINK_QUEUE_SIZE ) || ( this->framesCount == HXRC_MAVLINK_QUEUE_FRAMES_MAX ) )
+    {
+        //frame is not allowed to push out frames of higher class
+        if ( dropFrame( info.frameClass ) ) continue;
+
+        this->droppedBytesTotal += info.length;
+        this->framesDropped++;
+        return;
+    }
+
+    view.copyTo( this->buffer + this->bufferCount );
+    this->bufferCount += info.length;
+    this->frames[ this->framesCount++ ] = info;
+    this->framesQueued++;
+}
+
+//=====================================================================
+//=====================================================================
+//Incomplete frame from previous call and new data are parsed as two spans, so data is not copied
+//except for the incomplete frame at the end.
+void HXRCMavlinkFrameQueue::parse( const uint8_t* data, uint16_t length )
+{
+    this->parser.setInput( this->tail, this->tailCount, data, length );
+
+    HXMavlinkFrameView view;
+    while ( this->parser.next( &view ) ) enqueueFrame( view );
+
+    uint16_t consumed = this->parser.getConsumed();
+    if ( consumed < this->tailCount )
+    {
+        memmove( this->tail, this->tail + consumed, this->tailCount - consumed );
+        this->tailCount -= consumed;
+        consumed = 0;
+    }
+    else
+    {
+        consumed -= this->tailCount;
+        this->tailCount = 0;
+    }
+
+    //parser never leaves more than one incomplete frame
+    memcpy( this->tail + this->tailCount, data + consumed, length - consumed );
+    this->tailCount += length - consumed;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCMavlinkFrameQueue::send( const void* data, uint16_t lenToWrite )
+{
+    const uint8_t* p = (const uint8_t*)data;
+
+    //parser input length is 16 bit
+    while ( lenToWrite > 0 )
+    {
+        uint16_t n = lenToWrite > HXRC_MAVLINK_QUEUE_SIZE ? HXRC_MAVLINK_QUEUE_SIZE : lenToWrite;
+        parse( p, n );
+        p += n;
+        lenToWrite -= n;
+    }
+
+    this->droppedBytesTotal += this->parser.garbageBytes - this->garbageBytes;
+    this->garbageBytes = this->parser.garbageBytes;
+    this->crcErrors = this->parser.crcErrors;
+    this->unknownFrames = this->parser.unknownFrames;
+
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCMavlinkFrameQueue::receiveUpTo( uint16_t maxLen, uint8_t* toPtr )
+{
+    uint16_t pos = 0;
+
+    while ( ( this->framesCount > 0 ) && ( pos < maxLen ) )
+    {
+        uint16_t remaining = this->frames[0].length - this->headSent;
+
+        if ( remaining <= maxLen - pos )
+        {
+            memcpy( toPtr + pos, this->buffer + this->headSent, remaining );
+            pos += remaining;
+            this->headSent = 0;
+            removeFrame( 0 );
+            continue;
+        }
+
+        //frame does not fit. Split it only if it is already started or chunk is empty and large enough.
+        if ( ( this->headSent > 0 ) || ( ( pos == 0 ) && ( maxLen >= HXRC_MAVLINK_QUEUE_MIN_SPLIT ) ) )
+        {
+            uint16_t n = maxLen - pos;
+            memcpy( toPtr + pos, this->buffer + this->headSent, n );
+            pos += n;
+            this->headSent += n;
+        }
+        break;
+    }
+
+    return pos;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXRCMavlinkFrameQueue::getDroppedBytesTotal()
+{
+    return this->droppedBytesTotal;
+}
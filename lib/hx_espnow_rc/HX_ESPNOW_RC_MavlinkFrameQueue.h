@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_RingBuffer.h"
+#include "hx_mavlink_span_parser.h"
+
+#define HXRC_MAVLINK_QUEUE_SIZE         512
+#define HXRC_MAVLINK_QUEUE_FRAMES_MAX   32
+//v2 frame with signature
+#define HXRC_MAVLINK_FRAME_SIZE_MAX     280
+//frame which does not fit into remaining space of the chunk is split only if this space is at least this size
+#define HXRC_MAVLINK_QUEUE_MIN_SPLIT    16
+
+#define HXRC_MAVLINK_STX_V1             0xFE
+#define HXRC_MAVLINK_STX_V2             0xFD
+
+//=====================================================================
+//=====================================================================
+//frame classes, in order frames are dropped on overflow
+#define HXRC_MAVLINK_FRAME_STREAM       0   //periodic telemetry, replaced by newer one
+#define HXRC_MAVLINK_FRAME_NORMAL       1   //queued in order, f.e. chunks of log download or MAVFTP
+#define HXRC_MAVLINK_FRAME_PRIORITY     2   //commands, parameters, missions, dropped last
+
+//=====================================================================
+//=====================================================================
+typedef struct
+{
+    uint16_t length;
+    uint32_t msgId;
+    uint8_t sysId;
+    uint8_t compId;
+    //HXRC_MAVLINK_FRAME_xxx
+    uint8_t frameClass;
+} HXRCMavlinkFrameInfo;
+
+//=====================================================================
+//=====================================================================
+//Outgoing telemetry buffer which is aware of MAVLink v1/v2 framing.
+//Bytes written with send() are split into frames by HXMavlinkSpanParser. Frames of known messages are queued
+//only with valid CRC, on CRC error parser resyncs from the next byte after STX. Frames of messages outside of
+//common/ardupilotmega dialects are passed as normal frames without CRC check.
+//If input is already validated (setValidatedInput()), frames are only split by header length. receiveUpTo() returns whole frames
+//where possible, so a frame is split between chunks only if it does not fit.
+//On overflow, whole frames are dropped: oldest frames of the lowest class first. Incoming frame can push out
+//only frames of the same or lower class.
+//A queued periodic stream message (f.e. ATTITUDE) is replaced by a newer one with the same msgId/sysId/compId.
+//Other messages (f.e. LOG_DATA, FILE_TRANSFER_PROTOCOL, GPS_RTCM_DATA) are sequenced transfers and are never replaced.
+//Bytes outside of MAVLink frames are discarded.
+//Not thread safe: send() and receiveUpTo() should be called from loop thread.
+class HXRCMavlinkFrameQueue : public HXRCRingBufferInterface
+{
+private:
+    //queued frames, back to back
+    uint8_t buffer[HXRC_MAVLINK_QUEUE_SIZE];
+    uint16_t bufferCount;
+
+    HXRCMavlinkFrameInfo frames[HXRC_MAVLINK_QUEUE_FRAMES_MAX];
+    uint8_t framesCount;
+    //bytes of first frame already taken by receiveUpTo()
+    uint16_t headSent;
+
+    //incomplete frame left from previous send()
+    uint8_t tail[HXRC_MAVLINK_FRAME_SIZE_MAX];
+    uint16_t tailCount;
+    HXMavlinkSpanParser parser;
+
+    uint32_t droppedBytesTotal;
+
+    static bool isPriorityMessage( uint32_t msgId );
+    static bool isStreamMessage( uint32_t msgId );
+
+    uint16_t getFrameOffset( uint8_t index );
+    void removeFrame( uint8_t index );
+    bool dropFrame( uint8_t maxClass );
+    void enqueueFrame( const HXMavlinkFrameView& view );
+    void parse( const uint8_t* data, uint16_t length );
+
+public:
+    uint32_t framesQueued;
+    uint32_t framesDropped;
+    uint32_t framesDeduplicated;
+    uint32_t garbageBytes;
+    uint32_t crcErrors;
+    uint32_t unknownFrames;
+
+    HXRCMavlinkFrameQueue();
+
+    void reset();
+
+    //input contains only whole frames validated earlier (f.e. by HXRCMavlinkStreamFilter): CRC is not checked again
+    void setValidatedInput( bool validated );
+
+    //always consumes all data
+    bool send( const void* data, uint16_t lenToWrite );
+    uint16_t receiveUpTo( uint16_t maxLen, uint8_t* toPtr );
+    uint32_t getDroppedBytesTotal();
+};
@@ -0,0 +1,207 @@
+#include "HX_ESPNOW_RC_MavlinkStreamFilter.h"
+#include "HX_ESPNOW_RC_Common.h"
+
+//=====================================================================
+//=====================================================================
+HXRCMavlinkStreamFilter::HXRCMavlinkStreamFilter()
+{
+    this->parser.setPassUnknownMessages( true );
+    init( NULL, 0 );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkStreamFilter::init( const HXRCMavlinkFilterRule* rules, uint8_t rulesCount )
+{
+    if ( rulesCount > HXRC_MAVLINK_FILTER_RULES_MAX ) rulesCount = HXRC_MAVLINK_FILTER_RULES_MAX;
+    this->rulesCount = rulesCount;
+
+    unsigned long t = millis();
+    for ( uint8_t i = 0; i < rulesCount; i++ )
+    {
+        this->rules[i] = rules[i];
+        this->lastPassTime[i] = t - rules[i].intervalMs;
+    }
+
+    this->inputCount = 0;
+    this->parsed = 0;
+    this->frame = this->input;
+    this->frameLength = 0;
+
+    resetStats();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkStreamFilter::resetStats()
+{
+    this->msgStatsCount = 0;
+    memset( &this->otherStats, 0, sizeof( this->otherStats ) );
+
+    this->framesPassed = 0;
+    this->framesDropped = 0;
+    this->garbageBytes = 0;
+    this->crcErrors = 0;
+    this->unknownFrames = 0;
+    this->parser.init();
+}
+
+//=====================================================================
+//=====================================================================
+HXRCMavlinkFilterMsgStats* HXRCMavlinkStreamFilter::getMsgStatsEntry( uint32_t msgId )
+{
+    for ( uint8_t i = 0; i < this->msgStatsCount; i++ )
+    {
+        if ( this->msgStats[i].msgId == msgId ) return &this->msgStats[i];
+    }
+
+    if ( this->msgStatsCount == HXRC_MAVLINK_FILTER_STATS_SIZE ) return &this->otherStats;
+
+    HXRCMavlinkFilterMsgStats* s = &this->msgStats[ this->msgStatsCount++ ];
+    memset( s, 0, sizeof( *s ) );
+    s->msgId = msgId;
+    return s;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCMavlinkStreamFilter::passFrame( uint32_t msgId )
+{
+    //HEARTBEAT, COMMAND_ACK
+    if ( ( msgId == 0 ) || ( msgId == 77 ) ) return true;
+
+    for ( uint8_t i = 0; i < this->rulesCount; i++ )
+    {
+        const HXRCMavlinkFilterRule& rule = this->rules[i];
+        if ( rule.msgId != msgId ) continue;
+
+        if ( rule.intervalMs == HXRC_MAVLINK_FILTER_DROP ) return false;
+
+        unsigned long t = millis();
+        if ( ( t - this->lastPassTime[i] ) < rule.intervalMs ) return false;
+        this->lastPassTime[i] = t;
+        return true;
+    }
+
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+//parsed bytes are discarded from input on write(), so there is always space for at least one whole frame
+uint16_t HXRCMavlinkStreamFilter::getAvailableForWrite()
+{
+    return HXRC_MAVLINK_FILTER_INPUT_SIZE - this->inputCount + this->parsed;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCMavlinkStreamFilter::write( const uint8_t* data, uint16_t length )
+{
+    if ( this->parsed > 0 )
+    {
+        memmove( this->input, this->input + this->parsed, this->inputCount - this->parsed );
+        this->inputCount -= this->parsed;
+        this->parsed = 0;
+    }
+    this->frameLength = 0;
+
+    uint16_t space = HXRC_MAVLINK_FILTER_INPUT_SIZE - this->inputCount;
+    if ( length > space ) length = space;
+
+    memcpy( this->input + this->inputCount, data, length );
+    this->inputCount += length;
+    return length;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCMavlinkStreamFilter::nextFrame()
+{
+    this->frameLength = 0;
+
+    while ( true )
+    {
+        HXMavlinkFrameView view;
+        this->parser.setInput( this->input + this->parsed, this->inputCount - this->parsed );
+        bool found = this->parser.next( &view );
+        this->parsed += this->parser.getConsumed();
+
+        this->garbageBytes = this->parser.garbageBytes;
+        this->crcErrors = this->parser.crcErrors;
+        this->unknownFrames = this->parser.unknownFrames;
+
+        if ( !found ) return false;
+
+        uint16_t length = view.getLength();
+        HXRCMavlinkFilterMsgStats* s = getMsgStatsEntry( view.msgId );
+        s->framesIn++;
+        s->bytesIn += length;
+
+        if ( !passFrame( view.msgId ) )
+        {
+            this->framesDropped++;
+            continue;
+        }
+
+        s->framesPassed++;
+        s->bytesPassed += length;
+        this->framesPassed++;
+
+        //single span input: frame is contiguous
+        this->frame = view.part1;
+        this->frameLength = length;
+        return true;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+const uint8_t* HXRCMavlinkStreamFilter::getFrame() const
+{
+    return this->frame;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCMavlinkStreamFilter::getFrameLength() const
+{
+    return this->frameLength;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCMavlinkStreamFilter::getMsgStatsCount() const
+{
+    return this->msgStatsCount;
+}
+
+//=====================================================================
+//=====================================================================
+const HXRCMavlinkFilterMsgStats& HXRCMavlinkStreamFilter::getMsgStats( uint8_t index ) const
+{
+    return this->msgStats[index];
+}
+
+//=====================================================================
+//=====================================================================
+const HXRCMavlinkFilterMsgStats& HXRCMavlinkStreamFilter::getOtherStats() const
+{
+    return this->otherStats;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCMavlinkStreamFilter::printStats() const
+{
+    HXRCLOG.printf( "MAVLink filter: passed:%u dropped:%u garbage:%u crc errors:%u unknown:%u\n", this->framesPassed, this->framesDropped, this->garbageBytes, this->crcErrors, this->unknownFrames );
+    for ( uint8_t i = 0; i < this->msgStatsCount; i++ )
+    {
+        const HXRCMavlinkFilterMsgStats& s = this->msgStats[i];
+        HXRCLOG.printf( "  msg:%u frames:%u/%u bytes:%u/%u\n", s.msgId, s.framesPassed, s.framesIn, s.bytesPassed, s.bytesIn );
+    }
+    if ( this->otherStats.framesIn > 0 )
+    {
+        HXRCLOG.printf( "  other frames:%u/%u bytes:%u/%u\n", this->otherStats.framesPassed, this->otherStats.framesIn, this->otherStats.bytesPassed, this->otherStats.bytesIn );
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_MavlinkFrameQueue.h"
+#include "hx_mavlink_span_parser.h"
+
+//max rules in table
+#define HXRC_MAVLINK_FILTER_RULES_MAX   32
+//message ids with separate byte counters. Bytes of other messages are counted in "other".
+#define HXRC_MAVLINK_FILTER_STATS_SIZE  32
+
+//input buffer: incomplete frame and at least one whole frame
+#define HXRC_MAVLINK_FILTER_INPUT_SIZE  ( HXRC_MAVLINK_FRAME_SIZE_MAX * 2 )
+
+//rule interval: drop message
+#define HXRC_MAVLINK_FILTER_DROP        0xffff
+
+//=====================================================================
+//=====================================================================
+typedef struct
+{
+    uint32_t msgId;
+    //pass message not more often then once per intervalMs.
+    //0 - pass all, HXRC_MAVLINK_FILTER_DROP - drop all
+    uint16_t intervalMs;
+} HXRCMavlinkFilterRule;
+
+//=====================================================================
+//=====================================================================
+typedef struct
+{
+    uint32_t msgId;
+    uint32_t framesIn;
+    uint32_t framesPassed;
+    uint32_t bytesIn;
+    uint32_t bytesPassed;
+} HXRCMavlinkFilterMsgStats;
+
+//=====================================================================
+//=====================================================================
+//MAVLink stream filter for receivers.
+//Splits byte stream from flight controller into v1/v2 frames with HXMavlinkSpanParser and drops or decimates messages
+//according to per message id rules table. Messages without rule are passed.
+//HEARTBEAT and COMMAND_ACK are always passed.
+//Decimation state is kept per rule (per msgId), regardless of sysId/compId.
+//Frames with bad CRC and bytes outside of MAVLink frames are discarded. Parser resyncs from the next byte after STX,
+//so a stray STX does not swallow following frames.
+//Messages outside of common/ardupilotmega dialects are passed without CRC check (rules still apply).
+//Passed frames are valid, so HXRCMavlinkFrameQueue can take them without validation (HXRCConfig::mavlinkFrameQueueValidatedInput).
+//
+//Usage: write() data while getAvailableForWrite() > 0, then call nextFrame() until it returns false.
+class HXRCMavlinkStreamFilter
+{
+private:
+    HXRCMavlinkFilterRule rules[HXRC_MAVLINK_FILTER_RULES_MAX];
+    uint8_t rulesCount;
+    unsigned long lastPassTime[HXRC_MAVLINK_FILTER_RULES_MAX];
+
+    uint8_t input[HXRC_MAVLINK_FILTER_INPUT_SIZE];
+    uint16_t inputCount;
+    //bytes from the start of input which are parsed
+    uint16_t parsed;
+    HXMavlinkSpanParser parser;
+
+    //last passed frame, points into input
+    const uint8_t* frame;
+    uint16_t frameLength;
+
+    HXRCMavlinkFilterMsgStats msgStats[HXRC_MAVLINK_FILTER_STATS_SIZE];
+    uint8_t msgStatsCount;
+    HXRCMavlinkFilterMsgStats otherStats;
+
+    bool passFrame( uint32_t msgId );
+    HXRCMavlinkFilterMsgStats* getMsgStatsEntry( uint32_t msgId );
+
+public:
+    uint32_t framesPassed;
+    uint32_t framesDropped;
+    uint32_t garbageBytes;
+    uint32_t crcErrors;
+    uint32_t unknownFrames;
+
+    HXRCMavlinkStreamFilter();
+
+    //rules are copied. Rules above HXRC_MAVLINK_FILTER_RULES_MAX are ignored.
+    void init( const HXRCMavlinkFilterRule* rules, uint8_t rulesCount );
+
+    uint16_t getAvailableForWrite();
+    //returns number of bytes copied into input buffer
+    uint16_t write( const uint8_t* data, uint16_t length );
+
+    //returns true if next frame passed filter.
+    //Frame is available with getFrame() until next call of nextFrame() or write().
+    bool nextFrame();
+
+    const uint8_t* getFrame() const;
+    uint16_t getFrameLength() const;
+
+    //per message id counters, in order of first appearance
+    uint8_t getMsgStatsCount() const;
+    const HXRCMavlinkFilterMsgStats& getMsgStats( uint8_t index ) const;
+    //messages which did not fit into table
+    const HXRCMavlinkFilterMsgStats& getOtherStats() const;
+
+    void resetStats();
+    void printStats() const;
+};
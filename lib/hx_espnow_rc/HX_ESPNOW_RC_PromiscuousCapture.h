@@ -36,13 +36,16 @@ public:
     int8_t noiseFloor; //noise floor of Radio Frequency Module(RF). unit: 0.25dBm. In practice: in dbm
     int rate;
     uint32_t packetsCount;
+    int subscriberId;   //HXRCSniffer subscriber which fills this capture
 
     HXRCPromiscuousCapture()
     {
-        memset( peerMac, 0, 8);
+        memset( peerMac, 0, 6);
         rssi = 0;
         noiseFloor = 0;
         rate = -1;
+        packetsCount = 0;
+        subscriberId = -1;
     }
 };
 #endif
@@ -5,6 +5,7 @@
 //=====================================================================
 HXRCReceiverStats::HXRCReceiverStats()
 {
+    this->failsafePeriodMs = DEFAULT_FAILSAFE_PERIOD_MS;
     reset();
 }
 
@@ -14,7 +15,9 @@ void HXRCReceiverStats::reset()
 {
     unsigned long t = millis();
     
-    this->lastReceivedTimeMs = t - DEFAULT_FAILSAFE_PERIOD_MS;
+    this->lastReceivedTimeMs = t - this->failsafePeriodMs;
+    this->packetPeriod16 = DEFAULT_PACKET_SEND_PERIOD_MS * 16;
+    this->linkState.reset();
 
     this->prevPacketId = 0xffff;
     this->prevSequenceId = 0xffff;
@@ -36,14 +39,41 @@ void HXRCReceiverStats::reset()
     this->telemetrySpeedUpdateMs = t;
 
     this->telemetryOverflowCount = 0;
+    this->telemetryDesyncDropCount = 0;
+
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) this->streams[i].reset();
+    this->streamsUpdateMs = t;
 }
 
 //=====================================================================
 //=====================================================================
 bool HXRCReceiverStats::isFailsafe()    
 {
-    unsigned long delta = millis() - this->lastReceivedTimeMs;
-    return delta >= DEFAULT_FAILSAFE_PERIOD_MS;
+    return this->linkState.getState( getMsSinceLastPacket(), getPacketPeriodMs() ) == HXRC_LINK_STATE_FAILSAFE;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCReceiverStats::isSignalHold()    
+{
+    return this->linkState.getState( getMsSinceLastPacket(), getPacketPeriodMs() ) == HXRC_LINK_STATE_HOLD;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXRCReceiverStats::getMsSinceLastPacket()
+{
+    //lastReceivedTimeMs is updated from wifi task, read it before millis()
+    unsigned long last = this->lastReceivedTimeMs;
+    return millis() - last;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCReceiverStats::getPacketPeriodMs()
+{
+    uint16_t res = this->packetPeriod16 / 16;
+    return res > 0 ? res : 1;
 }
 
 //=====================================================================
@@ -101,8 +131,9 @@ bool HXRCReceiverStats::onPacketReceived( uint16_t packetId, uint16_t sequenceId
     {
         this->telemetryBytesReceivedTotal += telemetrySize;
     }
-    else
+    else if ( telemetrySize > 0 )
     {
+        //empty packet with the same sequenceId is sent while telemetry is held by coalescing, not a retransmit
         this->packetsRetransmit++;
     }
 
@@ -112,9 +143,17 @@ bool HXRCReceiverStats::onPacketReceived( uint16_t packetId, uint16_t sequenceId
         this->packetsLost += delta-1;
     }
 
+    unsigned long t = millis();
+    unsigned long dt = t - this->lastReceivedTimeMs;
+    if ( ( delta >= 1 ) && ( delta <= 8 ) && ( dt < 250 ) )
+    {
+        uint32_t sample = dt * 16 / delta;
+        this->packetPeriod16 = ( (uint32_t)this->packetPeriod16 * 7 + sample ) / 8;
+    }
+
     this->prevPacketId = packetId;
     this->prevSequenceId = sequenceId;
-    this->lastReceivedTimeMs = millis();
+    this->lastReceivedTimeMs = t;
 
     this->remoteRSSIDbm = RSSIDbm;
     this->remoteNoiseFloor = noiseFloor;
@@ -146,6 +185,16 @@ void HXRCReceiverStats::update()
 {
     getTelemetryReceivedSpeed(); 
     getRSSI(); 
+
+    this->linkState.update( getMsSinceLastPacket(), getPacketPeriodMs() );
+
+    unsigned long t = millis();
+    unsigned long dt = t - this->streamsUpdateMs;
+    if ( dt > 1000 )
+    {
+        for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) this->streams[i].closeWindow( dt );
+        this->streamsUpdateMs = t;
+    }
 }
 
 //=====================================================================
@@ -159,7 +208,15 @@ void HXRCReceiverStats::printStats()
     HXRCLOG.printf(" | Lost: %u", packetsLost);
     HXRCLOG.printf(" | Invalid/CRC: %u/%u", packetsInvalid, packetsCRCError);
     HXRCLOG.printf(" | Tel. overflow: %u", telemetryOverflowCount);
+    HXRCLOG.printf(" | Desync: %u", telemetryDesyncDropCount);
     HXRCLOG.printf(" | In telemetry: %d b/s\n", getTelemetryReceivedSpeed());
+    HXRCLOG.print(" In streams (b/s):");
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ )
+    {
+        HXRCLOG.printf(" | %d: %u", i, streams[i].speed);
+    }
+    HXRCLOG.printf(" | Period: %ums\n", getPacketPeriodMs());
+    this->linkState.printStats();
 }
 
 //=====================================================================
@@ -169,6 +226,15 @@ void HXRCReceiverStats::onTelemetryOverflow()
     this->telemetryOverflowCount++;  
 }
 
+//=====================================================================
+//=====================================================================
+//called from wifi task
+void HXRCReceiverStats::onStreamsReceived( const uint16_t* pBytes, uint16_t desyncDropCount )
+{
+    this->telemetryDesyncDropCount = desyncDropCount;
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) this->streams[i].onBytes( pBytes[i], pBytes[i], 0 );
+}
+
 //=====================================================================
 //=====================================================================
 void HXRCReceiverStats::onInvalidPacket()
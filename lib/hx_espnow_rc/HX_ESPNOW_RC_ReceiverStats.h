@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 #include "HX_ESPNOW_RC_Common.h"
+#include "HX_ESPNOW_RC_TelemetryMux.h"
+#include "HX_ESPNOW_RC_LinkState.h"
 
 //=====================================================================
 //=====================================================================
@@ -14,13 +16,21 @@ private:
 
     bool onPacketReceived( uint16_t packetId, uint16_t sequenceId, uint8_t telemetrySize, uint8_t RSSIDbm, uint8_t noiseFloor );
     void onTelemetryOverflow();
+    //desyncDropCount: total chunks dropped by out of sync decompressor
+    void onStreamsReceived( const uint16_t* pBytes, uint16_t desyncDropCount );
 
     friend class HXRCBase;
     friend class HXRCMaster;
     friend class HXRCSlave;
 
 public:
-    unsigned long lastReceivedTimeMs;
+    unsigned long failsafePeriodMs;
+    volatile unsigned long lastReceivedTimeMs;
+
+    //estimated packet period of peer, ms * 16
+    uint16_t packetPeriod16;
+    //signal hold/failsafe state and stats
+    HXRCLinkState linkState;
 
     uint16_t prevPacketId;
     uint16_t prevSequenceId;
@@ -46,6 +56,11 @@ public:
     unsigned long telemetrySpeedUpdateMs;
 
     uint16_t telemetryOverflowCount;
+    uint16_t telemetryDesyncDropCount;
+
+    //incoming telemetry per stream
+    HXRCStreamStats streams[HXRC_STREAMS_COUNT];
+    unsigned long streamsUpdateMs;
 
     uint8_t remoteRSSIDbm;
     uint8_t remoteNoiseFloor;
@@ -53,12 +68,16 @@ public:
     HXRCReceiverStats();
 
     bool isFailsafe();
+    //few consecutive frames are missed. Outputs should hold last values. False if failsafe.
+    bool isSignalHold();
+    unsigned long getMsSinceLastPacket();
+    uint16_t getPacketPeriodMs();
     uint8_t getRSSI();
     //The following values: 
-    //1) are awailable on Master only.
-    //2) are wailable only if slave is based on ESP32.
-    //3) are 0 if receiver is based on ESP8266
-    uint8_t getRemoteRSSIDbm();  //RSSI in Dbm on slave. 70 means -70Dbm
+    //1) are awailable on Master only (RSSIDbm is available on Slave also).
+    //2) are wailable only if peer is based on ESP32.
+    //3) are 0 if peer is based on ESP8266
+    uint8_t getRemoteRSSIDbm();  //RSSI in Dbm on peer. 70 means -70Dbm
     uint8_t getRemoteNoiseFloor();  //Noise floor on slave. 90 means - 90Dbm
     uint8_t getRemoteSNR(); //Signal to noise ratio on slave in Db.
 
@@ -15,6 +15,8 @@ class HXRCRingBufferInterface
     public:
         virtual bool send( const void* data, uint16_t lenToWrite ) = 0;
         virtual uint16_t receiveUpTo( uint16_t maxLen, uint8_t* toPtr ) = 0;
+        //bytes accepted by send() but discarded later
+        virtual uint32_t getDroppedBytesTotal() { return 0; }
 };
 
 
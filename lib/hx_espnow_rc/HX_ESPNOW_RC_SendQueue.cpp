@@ -0,0 +1,61 @@
+#include "HX_ESPNOW_RC_SendQueue.h"
+
+//=====================================================================
+//=====================================================================
+HXRCSendQueue::HXRCSendQueue()
+{
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSendQueue::reset()
+{
+    this->head = 0;
+    this->tail = 0;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCSendQueue::getCount() const
+{
+    return (uint8_t)(this->head - this->tail);
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCSendQueue::canSend() const
+{
+    return getCount() < HXRC_SEND_QUEUE_MAX_IN_FLIGHT;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSendQueue::reserve( uint16_t packetId, unsigned long timeMs )
+{
+    HXRCSendQueueItem& item = this->items[ this->head & (HXRC_SEND_QUEUE_SIZE - 1) ];
+    item.packetId = packetId;
+    item.sendTimeMs = timeMs;
+    __sync_synchronize();
+    this->head++;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSendQueue::cancel()
+{
+    this->head--;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXRCSendQueue::complete()
+{
+    if ( this->head == this->tail ) return 0;  //should not happen
+
+    const HXRCSendQueueItem& item = this->items[ this->tail & (HXRC_SEND_QUEUE_SIZE - 1) ];
+    unsigned long dt = millis() - item.sendTimeMs;
+    __sync_synchronize();
+    this->tail++;
+    return dt;
+}
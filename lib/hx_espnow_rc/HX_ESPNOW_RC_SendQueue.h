@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#define HXRC_SEND_QUEUE_SIZE            4   //power of 2
+//allow this number of esp_now_send() calls to wait for send callback
+#define HXRC_SEND_QUEUE_MAX_IN_FLIGHT   2
+
+//=====================================================================
+//=====================================================================
+typedef struct
+{
+    uint16_t packetId;
+    unsigned long sendTimeMs;
+} HXRCSendQueueItem;
+
+//=====================================================================
+//=====================================================================
+//Tracks frames passed to esp_now_send() until send callback is called.
+//Single producer (loop thread): reserve()/cancel(); single consumer (wifi task): complete().
+//Frame is reserved before esp_now_send(), because callback can be called before esp_now_send() returns.
+class HXRCSendQueue
+{
+private:
+    HXRCSendQueueItem items[HXRC_SEND_QUEUE_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+
+public:
+    HXRCSendQueue();
+
+    void reset();
+
+    bool canSend() const;
+    uint8_t getCount() const;
+
+    void reserve( uint16_t packetId, unsigned long timeMs );
+    //esp_now_send() failed
+    void cancel();
+
+    //returns time the frame spent in queue, ms
+    unsigned long complete();
+};
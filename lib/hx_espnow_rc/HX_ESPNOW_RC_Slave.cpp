@@ -20,6 +20,8 @@ HXRCSlave::HXRCSlave() : HXRCBase()
 {
     HXRCSlave::pInstance = this;
     this->gotIncomingPacket = false;
+    this->receivedChannelsCounter = 0;
+    this->receivedChannelsTimeUs = 0;
 #if defined(ESP32)
     this->channelsMutex = xSemaphoreCreateMutex();
     if( this->channelsMutex == NULL )
@@ -48,11 +50,7 @@ void HXRCSlave::OnDataSent(uint8_t *mac_addr, uint8_t status)
 void HXRCSlave::OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status)
 #endif
 {
-    if( status != ESP_NOW_SEND_SUCCESS )
-    {
-        transmitterStats.onPacketSendError();
-    }
-    senderState = HXRCSS_READY_TO_SEND;
+    onFrameSent( status == ESP_NOW_SEND_SUCCESS );
 }
 
 //=====================================================================
@@ -80,11 +78,15 @@ void HXRCSlave::OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int
             {
                 esp8266::InterruptLock lock;
                 memcpy(&receivedChannels, &pPayload->channels, sizeof(receivedChannels));
+                this->receivedChannelsCounter++;
+                this->receivedChannelsTimeUs = micros();
             }
 #elif(ESP32)
-            if ( xSemaphoreTake( this->channelsMutex,  (TickType_t) 100) == pdTRUE );
+            if ( xSemaphoreTake( this->channelsMutex,  (TickType_t) 100) == pdTRUE )
             {
                 memcpy(&receivedChannels, &pPayload->channels, sizeof(receivedChannels));
+                this->receivedChannelsCounter++;
+                this->receivedChannelsTimeUs = micros();
                 xSemaphoreGive( this->channelsMutex);
             }
 #endif
@@ -93,15 +95,17 @@ void HXRCSlave::OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int
             memcpy( capture.peerMac, mac, 6 );
 #endif            
 
-            if ( receiverStats.onPacketReceived( pPayload->packetId, pPayload->sequenceId, pPayload->length, 0, 0  ) )
+            if ( receiverStats.onPacketReceived( pPayload->packetId, pPayload->sequenceId, pPayload->length, pPayload->RSSIDbm, 0  ) )
             {
-                if ( !this->incomingTelemetryBuffer.send( pPayload->data, pPayload->length ) )  //length = 0 is ok
-                {
-                    receiverStats.onTelemetryOverflow();
-                }
+                processIncomingTelemetry( pPayload->data, pPayload->length, pPayload->sequenceId );  //length = 0 is ok
             }
             this->receivedSequenceId = pPayload->sequenceId;
 
+            if ( ( pPayload->nextChannel != 0 ) && ( this->pendingChannel == 0 ) )
+            {
+                scheduleChannelSwitch( pPayload->nextChannel, ((unsigned long)pPayload->channelSwitchTime10ms) * 10 );
+            }
+
             if ( this->waitAck && ( outgoingData.sequenceId == pPayload->ackSequenceId ) )
             {
                 this->waitAck = false;
@@ -152,7 +156,7 @@ bool HXRCSlave::init( HXRCConfig config )
 //=====================================================================
 void HXRCSlave::loop()
 {
-    if ( senderState == HXRCSS_READY_TO_SEND )
+    if ( canSend() )
     {
         unsigned long t = millis();
         //unsigned long deltaT = t - transmitterStats.lastSendTimeMs;
@@ -166,9 +170,13 @@ void HXRCSlave::loop()
 
             if ( !this->waitAck )
             {
-                outgoingData.sequenceId++;
-                outgoingData.length = outgoingTelemetryBuffer.receiveUpTo( HXRC_SLAVE_TELEMETRY_SIZE_MAX, outgoingData.data );
-                this->waitAck = true;
+                //on coalescing hold, send packet without telemetry under the same sequenceId:
+                //receiver ignores it as a duplicate, ack field is still delivered
+                if ( fillOutgoingTelemetry( outgoingData.data, this->config.getTelemetrySizeMax( HXRC_SLAVE_TELEMETRY_SIZE_MAX ), t, &outgoingData.length ) )
+                {
+                    outgoingData.sequenceId++;
+                    this->waitAck = true;
+                }
             }
 
             outgoingData.ackSequenceId = receivedSequenceId;
@@ -179,15 +187,7 @@ void HXRCSlave::loop()
 
             outgoingData.setCRC();
             transmitterStats.onPacketSend( t );
-            esp_err_t result = esp_now_send(BROADCAST_MAC, (uint8_t *) &outgoingData, HXRC_SLAVE_PAYLOAD_SIZE_BASE + outgoingData.length );
-            if (result == ESP_OK) 
-            {
-                senderState = HXRCSS_WAIT_SEND_FINISH;
-            }
-            else
-            {
-                transmitterStats.onPacketSendError();
-            }            
+            sendFrame( outgoingData.packetId, (uint8_t *) &outgoingData, HXRC_SLAVE_PAYLOAD_SIZE_BASE + outgoingData.length, t );
         }
 
     }
@@ -198,6 +198,13 @@ void HXRCSlave::loop()
 //=====================================================================
 //=====================================================================
 HXRCChannels HXRCSlave::getChannels()
+{
+    return getChannels( NULL, NULL );
+}
+
+//=====================================================================
+//=====================================================================
+HXRCChannels HXRCSlave::getChannels( uint32_t* pCounter, unsigned long* pReceivedTimeUs )
 {
     HXRCChannels ret;
 
@@ -205,6 +212,8 @@ HXRCChannels HXRCSlave::getChannels()
     {
         esp8266::InterruptLock lock;
         memcpy(&ret, &receivedChannels, sizeof(receivedChannels));
+        if ( pCounter ) *pCounter = this->receivedChannelsCounter;
+        if ( pReceivedTimeUs ) *pReceivedTimeUs = this->receivedChannelsTimeUs;
     }
 #elif defined (ESP32)
     if ( xSemaphoreTake( this->channelsMutex,  portMAX_DELAY ) != pdTRUE )
@@ -212,6 +221,8 @@ HXRCChannels HXRCSlave::getChannels()
         Serial.println("HXRC: Failed to get mutex");
     }
     memcpy(&ret, &receivedChannels, sizeof(receivedChannels));
+    if ( pCounter ) *pCounter = this->receivedChannelsCounter;
+    if ( pReceivedTimeUs ) *pReceivedTimeUs = this->receivedChannelsTimeUs;
     xSemaphoreGive( this->channelsMutex);
 #endif
 
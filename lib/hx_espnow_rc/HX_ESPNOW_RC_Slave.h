@@ -18,6 +18,9 @@ private:
     SemaphoreHandle_t channelsMutex;
 #endif    
     HXRCChannels receivedChannels;
+    //incremented on each received channels update
+    uint32_t receivedChannelsCounter;
+    unsigned long receivedChannelsTimeUs;
 
     HXRCSlavePayload outgoingData;
 #if defined(ESP8266)
@@ -43,6 +46,9 @@ public:
     //index = 0..15
     //data = 1000...2000
     HXRCChannels getChannels();
+    //pCounter: incremented on each received packet, allows to detect new data.
+    //pReceivedTimeUs: micros() when channels were received.
+    HXRCChannels getChannels( uint32_t* pCounter, unsigned long* pReceivedTimeUs );
 
     void setA1( uint32_t value);
     void setA2( uint32_t value);
@@ -0,0 +1,153 @@
+#include "HX_ESPNOW_RC_Sniffer.h"
+
+#if defined(ESP32)
+
+HXRCSniffer HXRCSniffer::instance;
+
+//=====================================================================
+//=====================================================================
+HXRCSniffer::HXRCSniffer()
+{
+    this->subscribersCount = 0;
+    this->recordSubscriberId = -1;
+    this->ringHead = 0;
+    this->ringTail = 0;
+    this->ringOverflowCount = 0;
+    this->framesTotal = 0;
+    this->started = false;
+}
+
+//=====================================================================
+//=====================================================================
+//https://esp32.com/viewtopic.php?t=13889
+void ICACHE_RAM_ATTR HXRCSniffer::callback(void *buf, wifi_promiscuous_pkt_type_t type)
+{
+    if ( (type != WIFI_PKT_MGMT) && (type != WIFI_PKT_DATA) ) return;
+
+    HXRCSniffer& self = HXRCSniffer::instance;
+    self.framesTotal++;
+
+    const wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)buf;
+    const wifi_ieee80211_packet_t *ipkt = (wifi_ieee80211_packet_t *)ppkt->payload;
+    const wifi_ieee80211_mac_hdr_t *hdr = &ipkt->hdr;
+
+    uint8_t subtype = hdr->frame_ctrl & 0xFF;
+    uint8_t count = self.subscribersCount;
+
+    for ( uint8_t i = 0; i < count; i++ )
+    {
+        const Subscriber& s = self.subscribers[i];
+
+        if ( !s.enabled ) continue;
+        if ( (s.frameSubtype != HXRC_SNIFFER_SUBTYPE_ANY) && (s.frameSubtype != subtype) ) continue;
+        if ( s.mac && (memcmp( hdr->addr2, s.mac, 6 ) != 0) ) continue;  //mac is first 6 digits
+
+        if ( s.callback ) s.callback( s.context, ppkt, hdr );
+
+        if ( s.record )
+        {
+            uint32_t head = self.ringHead;
+            if ( head - self.ringTail >= HXRC_SNIFFER_RING_SIZE )
+            {
+                self.ringOverflowCount++;
+            }
+            else
+            {
+                HXRCSnifferRecord& r = self.ring[ head & (HXRC_SNIFFER_RING_SIZE - 1) ];
+                r.timeUs = micros();
+                r.rssi = ppkt->rx_ctrl.rssi;
+                r.noiseFloor = ppkt->rx_ctrl.noise_floor;
+                r.rate = ppkt->rx_ctrl.rate;
+                r.subscriberId = i;
+                r.sigLen = ppkt->rx_ctrl.sig_len;
+                //publish record before moving head
+                __sync_synchronize();
+                self.ringHead = head + 1;
+            }
+        }
+    }
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSniffer::start()
+{
+    if ( this->started ) return;
+    this->started = true;
+
+    esp_wifi_set_promiscuous_rx_cb(&HXRCSniffer::callback);
+    esp_wifi_set_promiscuous(true);
+}
+
+//=====================================================================
+//=====================================================================
+int HXRCSniffer::subscribe( const uint8_t* mac, uint8_t frameSubtype, HXRCSnifferCallback callback, void* context, bool record )
+{
+    uint8_t id = this->subscribersCount;
+    if ( id >= HXRC_SNIFFER_SUBSCRIBERS_MAX )
+    {
+        Serial.println("HXRC: Error: Too many sniffer subscribers");
+        return -1;
+    }
+
+    if ( record && ( this->recordSubscriberId != -1 ) )
+    {
+        Serial.println("HXRC: Error: Sniffer record subscriber already exists");
+        return -1;
+    }
+
+    Subscriber& s = this->subscribers[id];
+    s.mac = mac;
+    s.frameSubtype = frameSubtype;
+    s.callback = callback;
+    s.context = context;
+    s.record = record;
+    s.enabled = true;
+
+    //make entry visible to wifi task before increasing count
+    __sync_synchronize();
+    this->subscribersCount = id + 1;
+
+    if ( record ) this->recordSubscriberId = id;
+
+    return id;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSniffer::setEnabled( int subscriberId, bool enabled )
+{
+    if ( (subscriberId < 0) || (subscriberId >= this->subscribersCount) ) return;
+    this->subscribers[subscriberId].enabled = enabled;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCSniffer::popRecord( HXRCSnifferRecord* pRecord )
+{
+    uint32_t tail = this->ringTail;
+    if ( tail == this->ringHead ) return false;
+
+    //read record before releasing slot
+    __sync_synchronize();
+    *pRecord = this->ring[ tail & (HXRC_SNIFFER_RING_SIZE - 1) ];
+    __sync_synchronize();
+    this->ringTail = tail + 1;
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXRCSniffer::getRingOverflowCount() const
+{
+    return this->ringOverflowCount;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXRCSniffer::getFramesTotal() const
+{
+    return this->framesTotal;
+}
+
+#endif
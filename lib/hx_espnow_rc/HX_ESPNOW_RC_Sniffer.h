@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_PromiscuousCapture.h"
+
+#if defined(ESP32)
+#include <esp_wifi.h>
+
+#define HXRC_SNIFFER_SUBSCRIBERS_MAX    4
+#define HXRC_SNIFFER_RING_SIZE          64      //power of 2
+
+#define HXRC_SNIFFER_SUBTYPE_ANY        0xff
+#define HXRC_SNIFFER_SUBTYPE_ACTION     0xd0    //esp-now packets are vendor specific action frames
+
+//=====================================================================
+//=====================================================================
+//radio metadata of single captured packet
+typedef struct
+{
+    uint32_t timeUs;        //micros() at capture time
+    int8_t rssi;            //dbm
+    int8_t noiseFloor;      //dbm
+    uint8_t rate;           //wifi_phy_rate_t
+    uint8_t subscriberId;
+    uint16_t sigLen;        //length of packet including FCS, bytes
+} HXRCSnifferRecord;
+
+//called from wifi task for each matching frame. Should be as short as possible.
+typedef void (*HXRCSnifferCallback)( void* context, const wifi_promiscuous_pkt_t* ppkt, const wifi_ieee80211_mac_hdr_t* hdr );
+
+//=====================================================================
+//=====================================================================
+//Single promiscuous callback which dispatches frames to subscribers.
+//Each subscriber filters by sender MAC (NULL - any sender) and frame subtype.
+//Metadata of frames matching "record" subscriber is pushed into lock-free ring buffer
+//(single producer: wifi task, single consumer: stats update in loop()).
+//Ring is not demultiplexed, so only one "record" subscriber is allowed.
+class HXRCSniffer
+{
+private:
+    typedef struct
+    {
+        //pointer is stored, so owner can change MAC later (f.e. capture.peerMac)
+        const uint8_t* mac;
+        uint8_t frameSubtype;
+        HXRCSnifferCallback callback;
+        void* context;
+        bool record;
+        volatile bool enabled;
+    } Subscriber;
+
+    Subscriber subscribers[HXRC_SNIFFER_SUBSCRIBERS_MAX];
+    volatile uint8_t subscribersCount;
+    int recordSubscriberId;
+
+    HXRCSnifferRecord ring[HXRC_SNIFFER_RING_SIZE];
+    volatile uint32_t ringHead;   //written by wifi task only
+    volatile uint32_t ringTail;   //written by consumer only
+    volatile uint32_t ringOverflowCount;
+
+    volatile uint32_t framesTotal;
+
+    bool started;
+
+    static void ICACHE_RAM_ATTR callback(void *buf, wifi_promiscuous_pkt_type_t type);
+
+public:
+    static HXRCSniffer instance;
+
+    HXRCSniffer();
+
+    //registers promiscuous callback and enables promiscuous mode
+    void start();
+
+    //returns subscriber id or -1 if subscribers table is full or "record" subscriber already exists
+    int subscribe( const uint8_t* mac, uint8_t frameSubtype, HXRCSnifferCallback callback, void* context, bool record );
+    void setEnabled( int subscriberId, bool enabled );
+
+    //single consumer only
+    bool popRecord( HXRCSnifferRecord* pRecord );
+
+    uint32_t getRingOverflowCount() const;
+    uint32_t getFramesTotal() const;
+};
+
+#endif
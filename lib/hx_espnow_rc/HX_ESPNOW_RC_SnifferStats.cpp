@@ -0,0 +1,131 @@
+#include "HX_ESPNOW_RC_SnifferStats.h"
+#include "HX_ESPNOW_RC_Common.h"
+
+#if defined(ESP32)
+
+//=====================================================================
+//=====================================================================
+HXRCSnifferStats::HXRCSnifferStats()
+{
+    this->subscriberId = -1;
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSnifferStats::reset()
+{
+    memset( this->rssiHistogram, 0, sizeof(this->rssiHistogram) );
+    memset( this->rateHistogram, 0, sizeof(this->rateHistogram) );
+    memset( this->lastRateCounts, 0, sizeof(this->lastRateCounts) );
+    this->windowPackets = 0;
+    this->windowStartMs = millis();
+
+    this->RSSIDbmP10 = 0;
+    this->RSSIDbmP50 = 0;
+    this->RSSIDbmP90 = 0;
+    this->lastWindowPackets = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSnifferStats::setSubscriberId( int subscriberId )
+{
+    this->subscriberId = subscriberId;
+}
+
+//=====================================================================
+//=====================================================================
+//percentile of signal strength: P10 is weak end, P90 is strong end
+uint8_t HXRCSnifferStats::percentileFromHistogram( uint8_t percent ) const
+{
+    if ( this->windowPackets == 0 ) return 0;
+
+    uint32_t threshold = ((uint32_t)this->windowPackets) * percent / 100;
+    uint32_t sum = 0;
+
+    //walk from weakest signal to strongest
+    for ( int i = HXRC_SNIFFER_STATS_RSSI_BINS - 1; i >= 0; i-- )
+    {
+        sum += this->rssiHistogram[i];
+        if ( sum > threshold ) return i;
+    }
+    return 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSnifferStats::closeWindow()
+{
+    this->RSSIDbmP10 = percentileFromHistogram(10);
+    this->RSSIDbmP50 = percentileFromHistogram(50);
+    this->RSSIDbmP90 = percentileFromHistogram(90);
+    this->lastWindowPackets = this->windowPackets;
+    memcpy( this->lastRateCounts, this->rateHistogram, sizeof(this->lastRateCounts) );
+
+    memset( this->rssiHistogram, 0, sizeof(this->rssiHistogram) );
+    memset( this->rateHistogram, 0, sizeof(this->rateHistogram) );
+    this->windowPackets = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSnifferStats::update()
+{
+    HXRCSnifferRecord r;
+    while ( HXRCSniffer::instance.popRecord( &r ) )
+    {
+        if ( r.subscriberId != this->subscriberId ) continue;
+
+        int bin = -r.rssi;
+        if ( bin < 0 ) bin = 0;
+        if ( bin >= HXRC_SNIFFER_STATS_RSSI_BINS ) bin = HXRC_SNIFFER_STATS_RSSI_BINS - 1;
+        this->rssiHistogram[bin]++;
+        this->rateHistogram[r.rate & (HXRC_SNIFFER_STATS_RATE_BINS - 1)]++;
+        this->windowPackets++;
+    }
+
+    unsigned long t = millis();
+    if ( t - this->windowStartMs > 1000 )
+    {
+        closeWindow();
+        this->windowStartMs = t;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+int HXRCSnifferStats::getDominantRate() const
+{
+    int res = -1;
+    uint16_t best = 0;
+    for ( int i = 0; i < HXRC_SNIFFER_STATS_RATE_BINS; i++ )
+    {
+        if ( this->lastRateCounts[i] > best )
+        {
+            best = this->lastRateCounts[i];
+            res = i;
+        }
+    }
+    return res;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCSnifferStats::printStats()
+{
+    HXRCLOG.printf(" RSSI P10/P50/P90: -%d/-%d/-%ddbm", this->RSSIDbmP10, this->RSSIDbmP50, this->RSSIDbmP90 );
+    HXRCLOG.printf(" | Captured: %up/s", this->lastWindowPackets );
+    HXRCLOG.printf(" | Overflow: %u", HXRCSniffer::instance.getRingOverflowCount() );
+    HXRCLOG.print(" | Rates:");
+    for ( int i = 0; i < HXRC_SNIFFER_STATS_RATE_BINS; i++ )
+    {
+        if ( this->lastRateCounts[i] > 0 )
+        {
+            HXRCLOG.printf(" %d:%u", i, this->lastRateCounts[i] );
+        }
+    }
+    HXRCLOG.print("\n");
+}
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_Sniffer.h"
+
+#if defined(ESP32)
+
+#define HXRC_SNIFFER_STATS_RSSI_BINS    128     //1dbm bins, 0...-127dbm
+#define HXRC_SNIFFER_STATS_RATE_BINS    32      //wifi_phy_rate_t 0..31
+
+//=====================================================================
+//=====================================================================
+//RSSI percentiles and rate distribution of packets recorded by sniffer,
+//computed over 1 second windows.
+class HXRCSnifferStats
+{
+private:
+    int subscriberId;
+
+    uint16_t rssiHistogram[HXRC_SNIFFER_STATS_RSSI_BINS];
+    uint16_t rateHistogram[HXRC_SNIFFER_STATS_RATE_BINS];
+    uint16_t windowPackets;
+    unsigned long windowStartMs;
+
+    uint8_t percentileFromHistogram( uint8_t percent ) const;
+    void closeWindow();
+
+public:
+    //values from last closed window. RSSI in dbm, 70 means -70dbm, 0 - no packets.
+    uint8_t RSSIDbmP10;
+    uint8_t RSSIDbmP50;
+    uint8_t RSSIDbmP90;
+    uint16_t lastWindowPackets;
+    uint16_t lastRateCounts[HXRC_SNIFFER_STATS_RATE_BINS];
+
+    HXRCSnifferStats();
+
+    void reset();
+
+    //accept records of this subscriber only
+    void setSubscriberId( int subscriberId );
+
+    //drain sniffer ring buffer; call from loop()
+    void update();
+
+    //rate with most packets in last window or -1
+    int getDominantRate() const;
+
+    void printStats();
+};
+
+#endif
@@ -0,0 +1,499 @@
+#include "HX_ESPNOW_RC_TelemetryMux.h"
+
+//=====================================================================
+//=====================================================================
+HXRCStreamStats::HXRCStreamStats()
+{
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCStreamStats::reset()
+{
+    this->bytesWindow = 0;
+    this->delaySumWindow = 0;
+    this->delayCountWindow = 0;
+    this->delayMaxWindow = 0;
+
+    this->bytesTotal = 0;
+    this->rawBytesTotal = 0;
+    this->speed = 0;
+    this->delayAvgMs = 0;
+    this->delayMaxMs = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCStreamStats::onBytes( uint16_t bytes, uint16_t rawBytes, unsigned long delayMs )
+{
+    if ( bytes == 0 ) return;
+
+    this->bytesTotal += bytes;
+    this->rawBytesTotal += rawBytes;
+    this->bytesWindow += bytes;
+    this->delaySumWindow += delayMs;
+    this->delayCountWindow++;
+    if ( delayMs > this->delayMaxWindow ) this->delayMaxWindow = delayMs;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCStreamStats::closeWindow( unsigned long dtMs )
+{
+    this->speed = dtMs > 0 ? this->bytesWindow * 1000 / dtMs : 0;
+    this->delayAvgMs = this->delayCountWindow > 0 ? this->delaySumWindow / this->delayCountWindow : 0;
+    this->delayMaxMs = this->delayMaxWindow;
+
+    this->bytesWindow = 0;
+    this->delaySumWindow = 0;
+    this->delayCountWindow = 0;
+    this->delayMaxWindow = 0;
+}
+
+//=====================================================================
+//=====================================================================
+HXRCTelemetryStream::HXRCTelemetryStream()
+{
+    init( NULL, NULL, 1 );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::init( HXRCRingBufferInterface* pIncoming, HXRCRingBufferInterface* pOutgoing, uint8_t weight )
+{
+    this->pIncoming = pIncoming;
+    this->pOutgoing = pOutgoing;
+    this->weight = weight;
+    this->deficit = 0;
+
+    this->rateLimit = 0;
+    this->tokens = 0;
+    this->tokensUpdateMs = millis();
+
+    this->outgoingBytesIn = 0;
+    this->outgoingBytesOut = 0;
+    this->outgoingBytesDropped = 0;
+    this->bufferLimit = 0;
+    this->marksHead = 0;
+    this->marksCount = 0;
+
+    this->pCompressor = NULL;
+    this->pDecompressor = NULL;
+    this->compressionEnabled = false;
+    this->compressorNeedsReset = true;
+    this->compressorResetMs = 0;
+    this->decompressorSynced = false;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::setOutgoingBuffer( HXRCRingBufferInterface* pOutgoing )
+{
+    this->pOutgoing = pOutgoing;
+
+    this->outgoingBytesIn = 0;
+    this->outgoingBytesOut = 0;
+    this->outgoingBytesDropped = pOutgoing != NULL ? pOutgoing->getDroppedBytesTotal() : 0;
+    this->marksHead = 0;
+    this->marksCount = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::setBufferLimit( uint16_t limit )
+{
+    this->bufferLimit = limit;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::setCompression( HXRCCompressor* pCompressor, HXRCDecompressor* pDecompressor )
+{
+    this->pCompressor = pCompressor;
+    this->pDecompressor = pDecompressor;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::enableCompression( bool enable )
+{
+    this->compressionEnabled = enable && ( this->pCompressor != NULL );
+    this->compressorNeedsReset = true;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::setWeight( uint8_t weight )
+{
+    this->weight = weight > 0 ? weight : 1;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::setRateLimit( uint16_t bytesPerSecond )
+{
+    this->rateLimit = bytesPerSecond;
+    this->tokens = 0;
+    this->tokensUpdateMs = millis();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTelemetryStream::refillTokens( unsigned long t )
+{
+    if ( this->rateLimit == 0 ) return;
+
+    unsigned long dt = t - this->tokensUpdateMs;
+    uint32_t add = ((uint32_t)this->rateLimit) * dt / 1000;
+    if ( add == 0 ) return;
+
+    this->tokensUpdateMs += add * 1000 / this->rateLimit;
+    this->tokens += add;
+
+    //allow burst of 1/4 second
+    uint32_t maxTokens = this->rateLimit / 4 + 1;
+    if ( this->tokens > maxTokens ) this->tokens = maxTokens;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCTelemetryStream::send( const void* data, uint16_t len )
+{
+    if ( this->pOutgoing == NULL ) return false;
+    if ( len == 0 ) return true;
+    if ( ( this->bufferLimit > 0 ) && ( getPendingCount() + len > this->bufferLimit ) ) return false;
+    if ( !this->pOutgoing->send( data, len ) ) return false;
+
+    //if all marks are used, data is attributed to the newest mark
+    if ( this->marksCount < HXRC_STREAM_DELAY_MARKS )
+    {
+        uint8_t i = ( this->marksHead + this->marksCount ) % HXRC_STREAM_DELAY_MARKS;
+        this->markOffset[i] = this->outgoingBytesIn;
+        this->markTimeMs[i] = millis();
+        this->marksCount++;
+    }
+    this->outgoingBytesIn += len;
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCTelemetryStream::receiveUpTo( uint16_t maxLen, uint8_t* toPtr )
+{
+    if ( this->pIncoming == NULL ) return 0;
+    return this->pIncoming->receiveUpTo( maxLen, toPtr );
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXRCTelemetryStream::getPendingCount()
+{
+    if ( this->pOutgoing == NULL ) return 0;
+
+    uint32_t res = this->outgoingBytesIn - this->outgoingBytesOut;
+    res -= this->pOutgoing->getDroppedBytesTotal() - this->outgoingBytesDropped;
+    if ( this->pCompressor != NULL ) res += this->pCompressor->stagingCount;
+    return res;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXRCTelemetryStream::getPendingAgeMs( unsigned long t )
+{
+    if ( ( this->pCompressor != NULL ) && ( this->pCompressor->stagingCount > 0 ) ) return (unsigned long)-1;
+    if ( this->marksCount == 0 ) return 0;
+    return t - this->markTimeMs[ this->marksHead ];
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCTelemetryStream::take( uint16_t maxLen, uint8_t* toPtr, unsigned long t, unsigned long* pMaxDelayMs, uint8_t* pFlags, uint16_t* pRawBytes )
+{
+    *pFlags = 0;
+    *pRawBytes = 0;
+
+    if ( this->pOutgoing == NULL ) return 0;
+
+    //rate limit applies to bytes on air
+    if ( this->rateLimit > 0 )
+    {
+        refillTokens( t );
+        if ( maxLen > this->tokens ) maxLen = this->tokens;
+    }
+    if ( maxLen == 0 ) return 0;
+
+    uint16_t len = 0;
+    HXRCCompressor* c = this->pCompressor;
+
+    if ( this->compressionEnabled )
+    {
+        if ( c->stagingCount < HXRC_COMPRESSION_STAGING_SIZE )
+        {
+            c->stagingCount += takeRaw( HXRC_COMPRESSION_STAGING_SIZE - c->stagingCount, c->staging + c->stagingCount, t, pMaxDelayMs );
+        }
+
+        //smallest token is 2 bytes
+        if ( ( c->stagingCount == 0 ) || ( maxLen < 2 ) ) return 0;
+
+        if ( this->compressorNeedsReset || ( t - this->compressorResetMs >= HXRC_COMPRESSION_RESYNC_MS ) )
+        {
+            c->reset();
+            this->compressorNeedsReset = false;
+            this->compressorResetMs = t;
+            *pFlags |= HXRC_STREAM_FLAG_RESET;
+        }
+
+        bool compressed;
+        len = c->compressStaging( toPtr, maxLen, pRawBytes, &compressed );
+        if ( compressed ) *pFlags |= HXRC_STREAM_FLAG_COMPRESSED;
+    }
+    else if ( ( c != NULL ) && ( c->stagingCount > 0 ) )
+    {
+        //compression was disabled: send rest of staging buffer uncompressed
+        len = maxLen < c->stagingCount ? maxLen : c->stagingCount;
+        memcpy( toPtr, c->staging, len );
+        c->stagingCount -= len;
+        memmove( c->staging, c->staging + len, c->stagingCount );
+        *pRawBytes = len;
+    }
+    else
+    {
+        len = takeRaw( maxLen, toPtr, t, pMaxDelayMs );
+        *pRawBytes = len;
+    }
+
+    if ( this->rateLimit > 0 ) this->tokens -= len;
+
+    return len;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXRCTelemetryStream::takeRaw( uint16_t maxLen, uint8_t* toPtr, unsigned long t, unsigned long* pMaxDelayMs )
+{
+    uint16_t len = this->pOutgoing->receiveUpTo( maxLen, toPtr );
+    if ( len == 0 ) return 0;
+
+    //oldest taken byte belongs to the oldest mark
+    if ( this->marksCount > 0 )
+    {
+        unsigned long delay = t - this->markTimeMs[ this->marksHead ];
+        if ( delay > *pMaxDelayMs ) *pMaxDelayMs = delay;
+    }
+
+    this->outgoingBytesOut += len;
+
+    //bytes discarded by buffer are accounted as taken
+    uint32_t dropped = this->pOutgoing->getDroppedBytesTotal();
+    this->outgoingBytesOut += dropped - this->outgoingBytesDropped;
+    this->outgoingBytesDropped = dropped;
+
+    //drop fully consumed marks
+    while ( this->marksCount > 0 )
+    {
+        if ( this->marksCount > 1 )
+        {
+            uint8_t next = ( this->marksHead + 1 ) % HXRC_STREAM_DELAY_MARKS;
+            if ( (int32_t)( this->markOffset[next] - this->outgoingBytesOut ) > 0 ) break;
+        }
+        else if ( this->outgoingBytesOut != this->outgoingBytesIn )
+        {
+            break;
+        }
+        this->marksHead = ( this->marksHead + 1 ) % HXRC_STREAM_DELAY_MARKS;
+        this->marksCount--;
+    }
+
+    return len;
+}
+
+//=====================================================================
+//=====================================================================
+HXRCTelemetryMux::HXRCTelemetryMux()
+{
+    this->rrIndex = HXRC_STREAM_DEFAULT;
+    this->desyncDropCount = 0;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCTelemetryMux::fill( uint8_t* data, uint8_t maxLen, unsigned long t, uint16_t* pBytes, uint16_t* pRawBytes, unsigned long* pDelayMs )
+{
+    uint8_t pos = 0;
+    uint8_t flags;
+    uint16_t rawBytes;
+
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ )
+    {
+        pBytes[i] = 0;
+        pRawBytes[i] = 0;
+        pDelayMs[i] = 0;
+    }
+
+    //control stream is served first
+    if ( maxLen > HXRC_STREAM_CHUNK_HEADER_SIZE )
+    {
+        uint16_t len = this->streams[HXRC_STREAM_CONTROL].take( maxLen - HXRC_STREAM_CHUNK_HEADER_SIZE, data + HXRC_STREAM_CHUNK_HEADER_SIZE, t, &pDelayMs[HXRC_STREAM_CONTROL], &flags, &rawBytes );
+        if ( len > 0 )
+        {
+            data[0] = HXRC_STREAM_CONTROL | flags;
+            data[1] = len;
+            pos += HXRC_STREAM_CHUNK_HEADER_SIZE + len;
+            pBytes[HXRC_STREAM_CONTROL] = len;
+            pRawBytes[HXRC_STREAM_CONTROL] = rawBytes;
+        }
+    }
+
+    //deficit round robin over other streams
+    const int streamsCount = HXRC_STREAMS_COUNT - 1;
+    int idleCount = 0;
+    while ( ( maxLen - pos > HXRC_STREAM_CHUNK_HEADER_SIZE ) && ( idleCount < streamsCount ) )
+    {
+        HXRCTelemetryStream& s = this->streams[this->rrIndex];
+        uint8_t streamId = this->rrIndex;
+        this->rrIndex = this->rrIndex + 1 < HXRC_STREAMS_COUNT ? this->rrIndex + 1 : HXRC_STREAM_DEFAULT;
+
+        //credit is kept while stream is limited by payload space, but not accumulated infinitely
+        s.deficit += s.weight * HXRC_STREAM_QUANTUM;
+        if ( s.deficit > s.weight * HXRC_STREAM_QUANTUM * 2 ) s.deficit = s.weight * HXRC_STREAM_QUANTUM * 2;
+
+        uint16_t space = maxLen - pos - HXRC_STREAM_CHUNK_HEADER_SIZE;
+        if ( space > (uint16_t)s.deficit ) space = s.deficit;
+
+        uint16_t len = s.take( space, data + pos + HXRC_STREAM_CHUNK_HEADER_SIZE, t, &pDelayMs[streamId], &flags, &rawBytes );
+        if ( len == 0 )
+        {
+            //empty or rate limited stream does not accumulate credit
+            s.deficit = 0;
+            idleCount++;
+            continue;
+        }
+
+        idleCount = 0;
+        s.deficit -= len;
+        data[pos] = streamId | flags;
+        data[pos+1] = len;
+        pos += HXRC_STREAM_CHUNK_HEADER_SIZE + len;
+        pBytes[streamId] += len;
+        pRawBytes[streamId] += rawBytes;
+    }
+
+    return pos;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCTelemetryMux::checkCoalesce( unsigned long t, uint8_t maxLen, uint16_t coalesceMs, uint16_t coalesceBytes )
+{
+    if ( coalesceMs == 0 ) return HXRC_COALESCE_IMMEDIATE;
+    if ( this->streams[HXRC_STREAM_CONTROL].getPendingCount() > 0 ) return HXRC_COALESCE_IMMEDIATE;
+
+    uint32_t pending = 0;
+    unsigned long maxAgeMs = 0;
+    for ( int i = HXRC_STREAM_DEFAULT; i < HXRC_STREAMS_COUNT; i++ )
+    {
+        uint32_t count = this->streams[i].getPendingCount();
+        if ( count == 0 ) continue;
+        pending += count;
+        unsigned long age = this->streams[i].getPendingAgeMs( t );
+        if ( age > maxAgeMs ) maxAgeMs = age;
+    }
+
+    if ( pending == 0 ) return HXRC_COALESCE_HOLD;
+
+    //threshold can not exceed single chunk capacity
+    if ( maxLen > HXRC_STREAM_CHUNK_HEADER_SIZE && coalesceBytes > maxLen - HXRC_STREAM_CHUNK_HEADER_SIZE ) 
+    {
+        coalesceBytes = maxLen - HXRC_STREAM_CHUNK_HEADER_SIZE;
+    }
+
+    if ( pending >= coalesceBytes ) return HXRC_COALESCE_SIZE;
+    if ( maxAgeMs >= coalesceMs ) return HXRC_COALESCE_TIMER;
+    return HXRC_COALESCE_HOLD;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCTelemetryMux::parse( const uint8_t* data, uint8_t len, bool sequenceGap, uint16_t* pBytes )
+{
+    bool res = true;
+    uint8_t pos = 0;
+
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) 
+    {
+        pBytes[i] = 0;
+        if ( sequenceGap ) this->streams[i].decompressorSynced = false;
+    }
+
+    while ( len - pos >= HXRC_STREAM_CHUNK_HEADER_SIZE )
+    {
+        uint8_t streamId = data[pos] & HXRC_STREAM_ID_MASK;
+        uint8_t flags = data[pos] & ~HXRC_STREAM_ID_MASK;
+        uint8_t chunkLen = data[pos+1];
+        pos += HXRC_STREAM_CHUNK_HEADER_SIZE;
+
+        if ( chunkLen > len - pos ) return false;   //malformed
+
+        //unknown streams are skipped
+        if ( streamId < HXRC_STREAMS_COUNT )
+        {
+            HXRCTelemetryStream& s = this->streams[streamId];
+
+            if ( s.pIncoming == NULL )
+            {
+                res = false;
+            }
+            else if ( flags & HXRC_STREAM_FLAG_COMPRESSED )
+            {
+                if ( ( s.pDecompressor != NULL ) && ( flags & HXRC_STREAM_FLAG_RESET ) )
+                {
+                    s.pDecompressor->reset();
+                    s.decompressorSynced = true;
+                }
+
+                if ( s.decompressorSynced )
+                {
+                    bool overflow = false;
+                    if ( !s.pDecompressor->decompress( data + pos, chunkLen, s.pIncoming, &overflow ) )
+                    {
+                        s.decompressorSynced = false;
+                    }
+                    if ( overflow ) res = false;
+                    pBytes[streamId] += chunkLen;
+                }
+                else
+                {
+                    //wait for window reset
+                    this->desyncDropCount++;
+                }
+            }
+            else
+            {
+                //incompressible chunk of compressed stream: data is usable as is, window advances over it
+                if ( s.pDecompressor != NULL )
+                {
+                    if ( flags & HXRC_STREAM_FLAG_RESET )
+                    {
+                        s.pDecompressor->reset();
+                        s.decompressorSynced = true;
+                    }
+                    if ( s.decompressorSynced ) s.pDecompressor->append( data + pos, chunkLen );
+                }
+
+                if ( !s.pIncoming->send( data + pos, chunkLen ) )
+                {
+                    res = false;
+                }
+                else
+                {
+                    pBytes[streamId] += chunkLen;
+                }
+            }
+        }
+
+        pos += chunkLen;
+    }
+
+    return res;
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "HX_ESPNOW_RC_RingBuffer.h"
+#include "HX_ESPNOW_RC_Compression.h"
+
+//Logical telemetry streams. Stream DEFAULT is used by legacy API (Mavlink etc.)
+#define HXRC_STREAM_CONTROL     0       //strict priority, small time-critical messages
+#define HXRC_STREAM_DEFAULT     1
+#define HXRC_STREAM_BULK        2       //low priority, f.e. parameters or log download
+#define HXRC_STREAMS_COUNT      3
+
+//data[] of payload is a sequence of chunks: [streamId][length][length bytes]
+#define HXRC_STREAM_CHUNK_HEADER_SIZE   2
+//flags in streamId byte
+#define HXRC_STREAM_ID_MASK             0x3F
+#define HXRC_STREAM_FLAG_COMPRESSED     0x80    //not set on incompressible chunks of compressed stream, window advances over them
+#define HXRC_STREAM_FLAG_RESET          0x40    //compression window is reset before this chunk
+
+#define HXRC_STREAM_DEFAULT_WEIGHT_DEFAULT  3
+#define HXRC_STREAM_BULK_WEIGHT_DEFAULT     1
+//bytes per weight unit added to deficit counter each scheduling round
+#define HXRC_STREAM_QUANTUM     16
+
+//result of HXRCTelemetryMux::checkCoalesce()
+#define HXRC_COALESCE_HOLD          0   //wait for more data
+#define HXRC_COALESCE_IMMEDIATE     1   //coalescing disabled or control stream has data
+#define HXRC_COALESCE_SIZE          2   //enough bytes collected
+#define HXRC_COALESCE_TIMER         3   //oldest byte waited long enough
+
+//number of timestamps kept to measure queueing delay
+#define HXRC_STREAM_DELAY_MARKS 8
+
+//=====================================================================
+//=====================================================================
+//per-stream throughput and queueing delay, computed over 1 second windows
+class HXRCStreamStats
+{
+private:
+    uint32_t bytesWindow;
+    uint32_t delaySumWindow;
+    uint16_t delayCountWindow;
+    unsigned long delayMaxWindow;
+
+public:
+    uint32_t bytesTotal;
+    //bytes before compression
+    uint32_t rawBytesTotal;
+    //values of last window
+    uint32_t speed;  //bytes/sec
+    unsigned long delayAvgMs;
+    unsigned long delayMaxMs;
+
+    HXRCStreamStats();
+
+    void reset();
+    void onBytes( uint16_t bytes, uint16_t rawBytes, unsigned long delayMs );
+    void closeWindow( unsigned long dtMs );
+};
+
+//=====================================================================
+//=====================================================================
+class HXRCTelemetryStream
+{
+private:
+    HXRCRingBufferInterface* pIncoming;
+    HXRCRingBufferInterface* pOutgoing;
+
+    uint8_t weight;
+    int16_t deficit;
+
+    //token bucket, bytes
+    uint16_t rateLimit;     //bytes/second, 0 - unlimited
+    uint32_t tokens;
+    unsigned long tokensUpdateMs;
+
+    //stream offset when data was added to outgoing buffer
+    uint32_t outgoingBytesIn;
+    uint32_t outgoingBytesOut;
+    uint32_t outgoingBytesDropped;
+    //max pending bytes, 0 - limited by buffer size only
+    uint16_t bufferLimit;
+    uint32_t markOffset[HXRC_STREAM_DELAY_MARKS];
+    unsigned long markTimeMs[HXRC_STREAM_DELAY_MARKS];
+    uint8_t marksHead;
+    uint8_t marksCount;
+
+    //optional compression
+    HXRCCompressor* pCompressor;
+    HXRCDecompressor* pDecompressor;
+    bool compressionEnabled;
+    bool compressorNeedsReset;
+    unsigned long compressorResetMs;
+    volatile bool decompressorSynced;
+
+    void refillTokens( unsigned long t );
+    uint16_t takeRaw( uint16_t maxLen, uint8_t* toPtr, unsigned long t, unsigned long* pMaxDelayMs );
+
+    friend class HXRCTelemetryMux;
+
+public:
+    HXRCTelemetryStream();
+
+    void init( HXRCRingBufferInterface* pIncoming, HXRCRingBufferInterface* pOutgoing, uint8_t weight );
+    //loop thread only, when link is not running
+    void setOutgoingBuffer( HXRCRingBufferInterface* pOutgoing );
+    //send() fails if more than limit bytes would be pending. 0 - no limit.
+    void setBufferLimit( uint16_t limit );
+
+    void setWeight( uint8_t weight );
+    void setRateLimit( uint16_t bytesPerSecond );
+
+    void setCompression( HXRCCompressor* pCompressor, HXRCDecompressor* pDecompressor );
+    //compress outgoing data. Incoming data is decompressed if sender compresses it.
+    void enableCompression( bool enable );
+
+    //loop thread only
+    bool send( const void* data, uint16_t len );
+    uint16_t receiveUpTo( uint16_t maxLen, uint8_t* toPtr );
+
+    //loop thread only. Number of bytes waiting in outgoing buffer, including bytes waiting for compression.
+    uint32_t getPendingCount();
+    //loop thread only. Time oldest pending byte spent in outgoing buffer.
+    //Bytes waiting for compression are considered expired.
+    unsigned long getPendingAgeMs( unsigned long t );
+
+    //take up to maxLen bytes of outgoing data.
+    //maxDelayMs: max time taken bytes spent in buffer
+    //pFlags: HXRC_STREAM_FLAG_xxx of the chunk, pRawBytes: bytes taken from stream before compression
+    uint16_t take( uint16_t maxLen, uint8_t* toPtr, unsigned long t, unsigned long* pMaxDelayMs, uint8_t* pFlags, uint16_t* pRawBytes );
+};
+
+//=====================================================================
+//=====================================================================
+//Packs outgoing streams into payload data[] and unpacks incoming data[] to streams.
+//Stream CONTROL is always served first. Other streams share remaining space using
+//deficit round robin with configured weights, limited by token bucket rate limit.
+class HXRCTelemetryMux
+{
+private:
+    uint8_t rrIndex;
+
+public:
+    HXRCTelemetryStream streams[HXRC_STREAMS_COUNT];
+
+    HXRCTelemetryMux();
+
+    //called by sender when new sequenceId is started
+    //pBytes, pRawBytes, pDelayMs: arrays of HXRC_STREAMS_COUNT elements, filled with per-stream stats
+    uint8_t fill( uint8_t* data, uint8_t maxLen, unsigned long t, uint16_t* pBytes, uint16_t* pRawBytes, unsigned long* pDelayMs );
+
+    //loop thread only. Decide if outgoing data should be sent now or held to collect more bytes.
+    //coalesceMs = 0 disables coalescing. Control stream is never held.
+    uint8_t checkCoalesce( unsigned long t, uint8_t maxLen, uint16_t coalesceMs, uint16_t coalesceBytes );
+
+    //called by receiver for new sequenceId. Returns false if any stream buffer overflowed.
+    //sequenceGap: some data was lost, decompressors should wait for window reset
+    //pBytes: array of HXRC_STREAMS_COUNT elements, filled with per-stream received bytes
+    bool parse( const uint8_t* data, uint8_t len, bool sequenceGap, uint16_t* pBytes );
+
+    //chunks dropped because decompressor was out of sync
+    uint16_t desyncDropCount;
+};
@@ -4,6 +4,7 @@
 //=====================================================================
 HXRCTransmitterStats::HXRCTransmitterStats()
 {
+    this->failsafePeriodMs = DEFAULT_FAILSAFE_PERIOD_MS;
     reset();
 }
 
@@ -18,8 +19,15 @@ void HXRCTransmitterStats::reset()
     this->packetsSentError = 0;
     this->packetsNotSentInTime = 0;
 
+    this->packetsQueued = 0;
+    this->maxQueueDepth = 0;
+    this->packetsSuperseded = 0;
+    this->maxSendTimeMs = 0;
+
     this->lastSendTimeMs = t;
-    this->lastAcknowledgedPacketMs = t - DEFAULT_FAILSAFE_PERIOD_MS;
+    this->lastAcknowledgedPacketMs = t - this->failsafePeriodMs;
+    this->packetPeriodMs = DEFAULT_PACKET_SEND_PERIOD_MS;
+    this->linkState.reset();
 
     this->RSSIPacketsAcknowledged = 0;
     this->RSSIPacketsTotal = 0;
@@ -31,14 +39,50 @@ void HXRCTransmitterStats::reset()
     this->lastTelemetryBytesSentSpeed = 0;
     this->lastTelemetryBytesSentTotal = 0;
     this->telemetrySpeedUpdateMs = t;
+
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) this->streams[i].reset();
+    this->streamsUpdateMs = t;
+
+    this->telemetryCommits = 0;
+    this->telemetryCommitsTimer = 0;
+    this->telemetryCommitsSize = 0;
+    this->telemetryCommitBytes = 0;
+    this->telemetryCommitCapacity = 0;
+
+    this->packetsInputSync = 0;
+    this->inputFramesSuperseded = 0;
+    this->inputFramesSent = 0;
+    this->inputLatencySumUs = 0;
+    this->inputLatencyMaxUs = 0;
+
+    this->pMavlinkQueue = NULL;
+
+#if defined(ESP32)
+    this->snifferStats.reset();
+#endif
 }
 
 //=====================================================================
 //=====================================================================
 bool HXRCTransmitterStats::isFailsafe()    
 {
-    unsigned long delta = millis() - this->lastAcknowledgedPacketMs;
-    return delta >= DEFAULT_FAILSAFE_PERIOD_MS;
+    return this->linkState.getState( getMsSinceLastAck(), this->packetPeriodMs ) == HXRC_LINK_STATE_FAILSAFE;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXRCTransmitterStats::isSignalHold()    
+{
+    return this->linkState.getState( getMsSinceLastAck(), this->packetPeriodMs ) == HXRC_LINK_STATE_HOLD;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXRCTransmitterStats::getMsSinceLastAck()
+{
+    //lastAcknowledgedPacketMs is updated from wifi task, read it before millis()
+    unsigned long last = this->lastAcknowledgedPacketMs;
+    return millis() - last;
 }
 
 //=====================================================================
@@ -147,6 +191,57 @@ void HXRCTransmitterStats::onPacketSendMiss( uint16_t missedPackets )
     this->packetsNotSentInTime += missedPackets;
 }
 
+//=====================================================================
+//=====================================================================
+void HXRCTransmitterStats::onPacketQueued( uint8_t queueDepth )
+{
+    if ( queueDepth > 1 ) this->packetsQueued++;
+    if ( queueDepth > this->maxQueueDepth ) this->maxQueueDepth = queueDepth;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTransmitterStats::onPacketSendComplete( unsigned long timeInQueueMs )
+{
+    if ( timeInQueueMs > this->maxSendTimeMs ) this->maxSendTimeMs = timeInQueueMs;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTransmitterStats::onPacketSuperseded( uint16_t count )
+{
+    this->packetsSuperseded += count;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTransmitterStats::onStreamsSent( const uint16_t* pBytes, const uint16_t* pRawBytes, const unsigned long* pDelayMs )
+{
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) this->streams[i].onBytes( pBytes[i], pRawBytes[i], pDelayMs[i] );
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTransmitterStats::onTelemetryCommit( uint8_t reason, uint8_t length, uint8_t maxLength )
+{
+    if ( length == 0 ) return;
+
+    this->telemetryCommits++;
+    if ( reason == HXRC_COALESCE_TIMER ) this->telemetryCommitsTimer++;
+    if ( reason == HXRC_COALESCE_SIZE ) this->telemetryCommitsSize++;
+    this->telemetryCommitBytes += length;
+    this->telemetryCommitCapacity += maxLength;
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTransmitterStats::onInputFrameSent( unsigned long latencyUs )
+{
+    this->inputFramesSent++;
+    this->inputLatencySumUs += latencyUs;
+    if ( this->inputLatencyMaxUs < latencyUs ) this->inputLatencyMaxUs = latencyUs;
+}
+
 //=====================================================================
 //=====================================================================
 //telemetry send speed stats, bytes/sec
@@ -171,6 +266,20 @@ void HXRCTransmitterStats::update()
 {
     getTelemetrySendSpeed(); 
     getRSSI(); 
+
+    this->linkState.update( getMsSinceLastAck(), this->packetPeriodMs );
+
+    unsigned long t = millis();
+    unsigned long dt = t - this->streamsUpdateMs;
+    if ( dt > 1000 )
+    {
+        for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ ) this->streams[i].closeWindow( dt );
+        this->streamsUpdateMs = t;
+    }
+#if defined(ESP32)
+    this->snifferStats.setSubscriberId( capture.subscriberId );
+    this->snifferStats.update();
+#endif
 }
 
 //=====================================================================
@@ -186,11 +295,47 @@ void HXRCTransmitterStats::printStats()
     HXRCLOG.printf(" | Missed time: %u", packetsNotSentInTime);
     HXRCLOG.printf(" | PacketRate: %dp/s", getSuccessfulPacketRate());
     HXRCLOG.printf(" | Out telemetry: %u b/s\n", getTelemetrySendSpeed());
+    HXRCLOG.printf(" Queued: %u", packetsQueued);
+    HXRCLOG.printf(" | Max depth: %u", maxQueueDepth);
+    HXRCLOG.printf(" | Superseded: %u", packetsSuperseded);
+    HXRCLOG.printf(" | Max send time: %lums\n", maxSendTimeMs);
+    HXRCLOG.printf(" Tel. commits: %u", telemetryCommits);
+    HXRCLOG.printf(" | Timer/Size: %u/%u", telemetryCommitsTimer, telemetryCommitsSize);
+    HXRCLOG.printf(" | Avg fill: %u%%\n", telemetryCommitCapacity > 0 ? (uint32_t)( (uint64_t)telemetryCommitBytes * 100 / telemetryCommitCapacity ) : 0 );
+    if ( inputFramesSent > 0 )
+    {
+        HXRCLOG.printf(" Input frames: %u", inputFramesSent);
+        HXRCLOG.printf(" | Superseded: %u", inputFramesSuperseded);
+        HXRCLOG.printf(" | Sync sent: %u", packetsInputSync);
+        HXRCLOG.printf(" | Latency avg/max: %lu/%luus\n", (unsigned long)( inputLatencySumUs / inputFramesSent ), inputLatencyMaxUs);
+    }
+    this->linkState.printStats();
+    HXRCLOG.print(" Out streams (b/s, avg/max delay):");
+    for ( int i = 0; i < HXRC_STREAMS_COUNT; i++ )
+    {
+        HXRCLOG.printf(" | %d: %u, %lu/%lums", i, streams[i].speed, streams[i].delayAvgMs, streams[i].delayMaxMs);
+        if ( streams[i].rawBytesTotal != streams[i].bytesTotal )
+        {
+            //compression ratio, raw/on air, percents
+            HXRCLOG.printf(", ratio %u%%", (uint32_t)( (uint64_t)streams[i].rawBytesTotal * 100 / streams[i].bytesTotal ) );
+        }
+    }
+    HXRCLOG.print("\n");
+    if ( this->pMavlinkQueue != NULL )
+    {
+        HXRCLOG.printf(" Mavlink frames: %u", this->pMavlinkQueue->framesQueued);
+        HXRCLOG.printf(" | Dropped: %u", this->pMavlinkQueue->framesDropped);
+        HXRCLOG.printf(" | Dedup: %u", this->pMavlinkQueue->framesDeduplicated);
+        HXRCLOG.printf(" | Unknown: %u", this->pMavlinkQueue->unknownFrames);
+        HXRCLOG.printf(" | Garbage: %u", this->pMavlinkQueue->garbageBytes);
+        HXRCLOG.printf(" | CRC errors: %u\n", this->pMavlinkQueue->crcErrors);
+    }
 #if defined(ESP32)
     HXRCLOG.printf(" RSSIDBm: -%ddbm", getRSSIDbm());
     HXRCLOG.printf(" | Noise Floor: -%ddbm", getNoiseFloor());
     HXRCLOG.printf(" | SNR: %ddb", getSNR());
     HXRCLOG.printf(" | WifiRate: %i\n", getRate());
+    this->snifferStats.printStats();
 #endif    
 }
 
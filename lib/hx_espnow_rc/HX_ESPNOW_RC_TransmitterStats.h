@@ -3,6 +3,10 @@
 #include <Arduino.h>
 
 #include "HX_ESPNOW_RC_Common.h"
+#include "HX_ESPNOW_RC_SnifferStats.h"
+#include "HX_ESPNOW_RC_TelemetryMux.h"
+#include "HX_ESPNOW_RC_LinkState.h"
+#include "HX_ESPNOW_RC_MavlinkFrameQueue.h"
 
 //=====================================================================
 //=====================================================================
@@ -16,6 +20,12 @@ private:
     void onPacketSend( unsigned long timeMs );
     void onPacketSendMiss( uint16_t missedPackets );
     void onPacketAck( uint8_t telemetryLength );
+    void onPacketQueued( uint8_t queueDepth );
+    void onPacketSendComplete( unsigned long timeInQueueMs );
+    void onPacketSuperseded( uint16_t count );
+    void onStreamsSent( const uint16_t* pBytes, const uint16_t* pRawBytes, const unsigned long* pDelayMs );
+    void onTelemetryCommit( uint8_t reason, uint8_t length, uint8_t maxLength );
+    void onInputFrameSent( unsigned long latencyUs );
 
     void update();
 
@@ -32,8 +42,23 @@ public:
     //packets not sent in time because HXRCLoop() was not called in time
     uint16_t packetsNotSentInTime;  
 
+    //packets sent while previous packet(s) were still waiting for send callback
+    uint16_t packetsQueued;
+    //max number of packets waiting for send callback
+    uint8_t maxQueueDepth;
+    //due packets which were held because send queue was full, and replaced by newer packet
+    uint16_t packetsSuperseded;
+    //max time from esp_now_send() to send callback
+    unsigned long maxSendTimeMs;
+
+    unsigned long failsafePeriodMs;
     unsigned long lastSendTimeMs;
-    unsigned long lastAcknowledgedPacketMs;
+    volatile unsigned long lastAcknowledgedPacketMs;
+
+    //expected period of acknowledges, ms
+    uint16_t packetPeriodMs;
+    //signal hold/failsafe state and stats, based on acknowledges
+    HXRCLinkState linkState;
 
     uint16_t RSSIPacketsAcknowledged;
     uint16_t RSSIPacketsTotal;
@@ -46,9 +71,42 @@ public:
     uint32_t lastTelemetryBytesSentTotal;
     unsigned long telemetrySpeedUpdateMs;
 
+    //outgoing telemetry per stream: throughput and time spent in outgoing buffer
+    HXRCStreamStats streams[HXRC_STREAMS_COUNT];
+    unsigned long streamsUpdateMs;
+
+    //packets with telemetry data
+    uint16_t telemetryCommits;
+    //commits caused by coalescing timer and size threshold
+    uint16_t telemetryCommitsTimer;
+    uint16_t telemetryCommitsSize;
+    //to compute average telemetry data fill
+    uint32_t telemetryCommitBytes;
+    uint32_t telemetryCommitCapacity;
+
+    //packets sent early in phase with input frames
+    uint16_t packetsInputSync;
+    //input frames replaced by newer frame before send
+    uint16_t inputFramesSuperseded;
+    //input frame to air latency, us
+    uint32_t inputFramesSent;
+    uint64_t inputLatencySumUs;
+    unsigned long inputLatencyMaxUs;
+
+    //frame counters of outgoing MAVLink queue, NULL if not used
+    const HXRCMavlinkFrameQueue* pMavlinkQueue;
+
+#if defined(ESP32)
+    //RSSI percentiles and rate distribution of packets from peer
+    HXRCSnifferStats snifferStats;
+#endif
+
     HXRCTransmitterStats();
 
     bool isFailsafe();
+    //few consecutive frames are not acknowledged. False if failsafe.
+    bool isSignalHold();
+    unsigned long getMsSinceLastAck();
     uint8_t getRSSI();  //0..100 computed link quality
     uint8_t getSuccessfulPacketRate();  //successful packed per second
 
@@ -0,0 +1,79 @@
+#include "HX_ESPNOW_RC_TxPower.h"
+#include "HX_ESPNOW_RC_Common.h"
+
+//=====================================================================
+//=====================================================================
+HXRCTxPowerController::HXRCTxPowerController()
+{
+    this->enabled = false;
+    this->power = HXRC_TX_POWER_MAX;
+    this->lastChangeMs = 0;
+}
+
+//=====================================================================
+//=====================================================================
+//HXRCInitEspNow() sets max power
+void HXRCTxPowerController::init( bool enabled )
+{
+    this->enabled = enabled;
+    this->power = HXRC_TX_POWER_MAX;
+    this->lastChangeMs = millis();
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTxPowerController::setPower( uint8_t value )
+{
+    if ( value > HXRC_TX_POWER_MAX ) value = HXRC_TX_POWER_MAX;
+    if ( value < HXRC_TX_POWER_MIN ) value = HXRC_TX_POWER_MIN;
+
+    this->lastChangeMs = millis();
+
+    if ( value == this->power ) return;
+    this->power = value;
+
+#if defined(ESP8266)
+    system_phy_set_max_tpw( value );
+#elif defined(ESP32)
+    esp_wifi_set_max_tx_power( value );
+#endif
+}
+
+//=====================================================================
+//=====================================================================
+void HXRCTxPowerController::update( uint8_t remoteRSSIDbm, unsigned long msSinceAck, uint16_t packetPeriodMs )
+{
+    if ( !this->enabled ) return;
+
+    unsigned long dt = millis() - this->lastChangeMs;
+
+    unsigned long lossMs = ((unsigned long)packetPeriodMs) * HXRC_TX_POWER_LOSS_PERIODS;
+    if ( lossMs < HXRC_TX_POWER_LOSS_MS_MIN ) lossMs = HXRC_TX_POWER_LOSS_MS_MIN;
+
+    if ( ( remoteRSSIDbm == 0 ) || ( msSinceAck > lossMs ) )
+    {
+        if ( this->power != HXRC_TX_POWER_MAX ) setPower( HXRC_TX_POWER_MAX );
+    }
+    else if ( remoteRSSIDbm > HXRC_TX_POWER_TARGET_RSSI_DBM )
+    {
+        if ( dt >= HXRC_TX_POWER_STEP_UP_PERIOD_MS ) setPower( this->power + HXRC_TX_POWER_STEP_UP );
+    }
+    else if ( remoteRSSIDbm < HXRC_TX_POWER_TARGET_RSSI_DBM - HXRC_TX_POWER_HYSTERESIS_DB )
+    {
+        if ( dt >= HXRC_TX_POWER_STEP_DOWN_PERIOD_MS ) setPower( this->power - HXRC_TX_POWER_STEP_DOWN );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCTxPowerController::getPower() const
+{
+    return this->power;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXRCTxPowerController::getPowerDbm() const
+{
+    return ( this->power + 2 ) / 4;
+}
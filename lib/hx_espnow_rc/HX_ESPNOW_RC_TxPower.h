@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+//TX power is in 0.25dbm units on both platforms
+#if defined(ESP8266)
+#define HXRC_TX_POWER_MAX                   82      //20.5dbm
+#elif defined(ESP32)
+#define HXRC_TX_POWER_MAX                   84      //21dbm
+#endif
+#define HXRC_TX_POWER_MIN                   8       //2dbm
+
+//keep RSSI on peer around -70dbm
+#define HXRC_TX_POWER_TARGET_RSSI_DBM       70
+#define HXRC_TX_POWER_HYSTERESIS_DB         6
+
+#define HXRC_TX_POWER_STEP_UP               8       //2dbm
+#define HXRC_TX_POWER_STEP_DOWN             2       //0.5dbm
+#define HXRC_TX_POWER_STEP_UP_PERIOD_MS     100
+#define HXRC_TX_POWER_STEP_DOWN_PERIOD_MS   500
+
+//no acknowledgement for this number of packet periods (but not less then HXRC_TX_POWER_LOSS_MS_MIN): jump to max power
+#define HXRC_TX_POWER_LOSS_PERIODS          3
+#define HXRC_TX_POWER_LOSS_MS_MIN           100
+
+//=====================================================================
+//=====================================================================
+//Closed loop TX power control.
+//Power is decreased slowly while peer reports strong signal,
+//increased quickly if peer signal is weak, and set to maximum on packet loss
+//or if peer can not report RSSI (ESP8266 peer reports 0).
+class HXRCTxPowerController
+{
+private:
+    bool enabled;
+    uint8_t power;
+    unsigned long lastChangeMs;
+
+    void setPower( uint8_t value );
+
+public:
+    HXRCTxPowerController();
+
+    void init( bool enabled );
+
+    //remoteRSSIDbm: RSSI reported by peer, 70 means -70dbm, 0 - unknown
+    //msSinceAck: time since last acknowledged packet
+    //packetPeriodMs: configured packet period
+    void update( uint8_t remoteRSSIDbm, unsigned long msSinceAck, uint16_t packetPeriodMs );
+
+    //0.25dbm units
+    uint8_t getPower() const;
+    uint8_t getPowerDbm() const;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <mavlink_types.h>
+
+//=====================================================================
+//=====================================================================
+//MAVLink common dialect with constant time message entry lookup.
+//Include this header instead of <common/mavlink.h>, before any other MAVLink header.
+//Define HX_MAVLINK_DIALECT_ARDUPILOTMEGA before including to use ardupilotmega dialect (superset of common) in this translation unit.
+//
+//Library finds CRC extra and length of every parsed message with bisection search over whole dialect table (~220 entries).
+//Here message ids 0..255 (MAVLink 1 range, contains all high rate telemetry messages) are resolved with index table
+//generated at compile time from MAVLINK_MESSAGE_CRCS. Other ids fall back to bisection search.
+
+#define MAVLINK_GET_MSG_ENTRY
+static inline const mavlink_msg_entry_t* mavlink_get_msg_entry( uint32_t msgid );
+
+#ifdef HX_MAVLINK_DIALECT_ARDUPILOTMEGA
+#include <ardupilotmega/mavlink.h>
+#else
+#include <common/mavlink.h>
+#endif
+
+#define HX_MAVLINK_MSG_INDEX_SIZE   256
+#define HX_MAVLINK_MSG_INDEX_NONE   0xff
+
+static constexpr mavlink_msg_entry_t hxMavlinkMsgEntries[] = MAVLINK_MESSAGE_CRCS;
+static constexpr uint16_t hxMavlinkMsgEntriesCount = sizeof( hxMavlinkMsgEntries ) / sizeof( hxMavlinkMsgEntries[0] );
+
+//=====================================================================
+//=====================================================================
+//index of first entry with id >= msgid in [low, high). Table is sorted by msgid.
+static constexpr uint16_t hxMavlinkMsgLowerBound( uint32_t msgid, uint16_t low, uint16_t high )
+{
+    return low >= high ? low :
+        hxMavlinkMsgEntries[ ( low + high ) / 2 ].msgid < msgid ?
+            hxMavlinkMsgLowerBound( msgid, ( low + high ) / 2 + 1, high ) :
+            hxMavlinkMsgLowerBound( msgid, low, ( low + high ) / 2 );
+}
+
+//=====================================================================
+//=====================================================================
+static constexpr uint8_t hxMavlinkMsgIndex( uint32_t msgid )
+{
+    return ( hxMavlinkMsgLowerBound( msgid, 0, hxMavlinkMsgEntriesCount ) < hxMavlinkMsgEntriesCount ) &&
+        ( hxMavlinkMsgEntries[ hxMavlinkMsgLowerBound( msgid, 0, hxMavlinkMsgEntriesCount ) ].msgid == msgid ) ?
+            hxMavlinkMsgLowerBound( msgid, 0, hxMavlinkMsgEntriesCount ) : HX_MAVLINK_MSG_INDEX_NONE;
+}
+
+//first entry above index range
+static constexpr uint16_t hxMavlinkMsgIndexEnd = hxMavlinkMsgLowerBound( HX_MAVLINK_MSG_INDEX_SIZE, 0, hxMavlinkMsgEntriesCount );
+static_assert( hxMavlinkMsgIndexEnd < HX_MAVLINK_MSG_INDEX_NONE, "MAVLink dialect has too many messages for 8-bit index" );
+
+#define HX_MAVLINK_MSG_INDEX_4(n)   hxMavlinkMsgIndex(n), hxMavlinkMsgIndex(n+1), hxMavlinkMsgIndex(n+2), hxMavlinkMsgIndex(n+3)
+#define HX_MAVLINK_MSG_INDEX_16(n)  HX_MAVLINK_MSG_INDEX_4(n), HX_MAVLINK_MSG_INDEX_4(n+4), HX_MAVLINK_MSG_INDEX_4(n+8), HX_MAVLINK_MSG_INDEX_4(n+12)
+#define HX_MAVLINK_MSG_INDEX_64(n)  HX_MAVLINK_MSG_INDEX_16(n), HX_MAVLINK_MSG_INDEX_16(n+16), HX_MAVLINK_MSG_INDEX_16(n+32), HX_MAVLINK_MSG_INDEX_16(n+48)
+
+//msgid => index in hxMavlinkMsgEntries, HX_MAVLINK_MSG_INDEX_NONE if message is not in dialect
+static constexpr uint8_t hxMavlinkMsgIndexTable[HX_MAVLINK_MSG_INDEX_SIZE] =
+{
+    HX_MAVLINK_MSG_INDEX_64(0), HX_MAVLINK_MSG_INDEX_64(64), HX_MAVLINK_MSG_INDEX_64(128), HX_MAVLINK_MSG_INDEX_64(192)
+};
+
+//=====================================================================
+//=====================================================================
+static inline const mavlink_msg_entry_t* mavlink_get_msg_entry( uint32_t msgid )
+{
+    if ( msgid < HX_MAVLINK_MSG_INDEX_SIZE )
+    {
+        uint8_t index = hxMavlinkMsgIndexTable[msgid];
+        return index == HX_MAVLINK_MSG_INDEX_NONE ? NULL : &hxMavlinkMsgEntries[index];
+    }
+
+    uint16_t low = hxMavlinkMsgIndexEnd;
+    uint16_t high = hxMavlinkMsgEntriesCount;
+    while ( low < high )
+    {
+        uint16_t mid = ( low + high ) / 2;
+        if ( hxMavlinkMsgEntries[mid].msgid < msgid )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return ( low < hxMavlinkMsgEntriesCount ) && ( hxMavlinkMsgEntries[low].msgid == msgid ) ? &hxMavlinkMsgEntries[low] : NULL;
+}
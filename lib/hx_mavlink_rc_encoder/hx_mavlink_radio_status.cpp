@@ -0,0 +1,153 @@
+#include "hx_mavlink_radio_status.h"
+
+#include "hx_mavlink_common.h"
+
+//RC encoder uses MAVLINK_COMM_0
+#define RADIO_STATUS_CHANNEL    MAVLINK_COMM_1
+
+//=====================================================================
+//=====================================================================
+HXMavlinkRadioStatus::HXMavlinkRadioStatus()
+{
+    this->init();
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkRadioStatus::init( uint16_t periodMs, bool mavlink_v1 )
+{
+    this->mavlink_v1 = mavlink_v1;
+    this->periodMs = periodMs;
+    this->lastSendTime = millis();
+
+    this->rssi = UINT8_MAX;
+    this->remrssi = UINT8_MAX;
+    this->noise = UINT8_MAX;
+    this->remnoise = UINT8_MAX;
+    this->txbuf = 100;
+    this->rxerrors = 0;
+
+    this->uplinkV1 = false;
+    this->uplinkCount = 0;
+    this->uplinkLength = 0;
+    this->lastUplinkTime = 0;
+
+    mavlink_status_t* status = mavlink_get_channel_status( RADIO_STATUS_CHANNEL );
+    if ( mavlink_v1 )
+    {
+        status->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    }
+    else
+    {
+        status->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+//UINT8_MAX - unknown
+uint8_t HXMavlinkRadioStatus::dbmToSiK( uint8_t dbm )
+{
+    if ( dbm == 0 ) return UINT8_MAX;
+    if ( dbm >= 127 ) return 0;
+    uint16_t v = ( 127 - dbm ) * 19 / 10;
+    return v > 254 ? 254 : v;
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkRadioStatus::setRSSIDbm( uint8_t localDbm, uint8_t remoteDbm )
+{
+    this->rssi = dbmToSiK( localDbm );
+    this->remrssi = dbmToSiK( remoteDbm );
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkRadioStatus::setNoiseFloorDbm( uint8_t localDbm, uint8_t remoteDbm )
+{
+    this->noise = dbmToSiK( localDbm );
+    this->remnoise = dbmToSiK( remoteDbm );
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkRadioStatus::setTxBufferFill( uint8_t percent )
+{
+    this->txbuf = percent >= 100 ? 0 : 100 - percent;
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkRadioStatus::setRxErrors( uint16_t count )
+{
+    this->rxerrors = count;
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkRadioStatus::onUplinkByte( uint8_t c )
+{
+    this->lastUplinkTime = millis();
+
+    if ( this->uplinkCount == 0 )
+    {
+        //bytes outside of frames are passed as is
+        if ( ( c != MAVLINK_STX_MAVLINK1 ) && ( c != MAVLINK_STX ) ) return;
+        this->uplinkV1 = c == MAVLINK_STX_MAVLINK1;
+        this->uplinkLength = 0;
+    }
+
+    this->uplinkCount++;
+
+    if ( this->uplinkCount == 2 )
+    {
+        //stx, len, seq, sysid, compid, msgid, payload, crc
+        //stx, len, incompat, compat, seq, sysid, compid, msgid[3], payload, crc, signature
+        this->uplinkLength = c + ( this->uplinkV1 ? 8 : 12 );
+    }
+    else if ( ( this->uplinkCount == 3 ) && !this->uplinkV1 && ( c & MAVLINK_IFLAG_SIGNED ) )
+    {
+        this->uplinkLength += MAVLINK_SIGNATURE_BLOCK_LEN;
+    }
+
+    if ( this->uplinkCount == this->uplinkLength ) this->uplinkCount = 0;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXMavlinkRadioStatus::getFrame( uint8_t* buffer )
+{
+    mavlink_message_t msg;
+    mavlink_msg_radio_status_pack_chan(
+            MAVLINK_RADIO_STATUS_SYSID, MAVLINK_RADIO_STATUS_COMPID,
+            RADIO_STATUS_CHANNEL,
+            &msg,
+            this->rssi, this->remrssi, this->txbuf, this->noise, this->remnoise, this->rxerrors, 0
+        );
+    return mavlink_msg_to_send_buffer( buffer, &msg );
+}
+
+//=====================================================================
+//=====================================================================
+bool HXMavlinkRadioStatus::loop( HardwareSerial& serial )
+{
+    unsigned long t = millis();
+    if ( ( t - this->lastSendTime ) < this->periodMs ) return false;
+
+    //do not break uplink frame
+    if ( this->uplinkCount > 0 )
+    {
+        if ( ( t - this->lastUplinkTime ) < MAVLINK_RADIO_STATUS_UPLINK_TIMEOUT_MS ) return false;
+        this->uplinkCount = 0;
+    }
+
+    if ( serial.availableForWrite() < MAVLINK_RADIO_STATUS_FRAME_SIZE_MAX ) return false;
+
+    uint8_t frame[MAVLINK_RADIO_STATUS_FRAME_SIZE_MAX];
+    uint8_t len = getFrame( frame );
+    serial.write( frame, len );
+
+    this->lastSendTime = t;
+    return true;
+}
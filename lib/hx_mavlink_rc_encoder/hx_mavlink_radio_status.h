@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#define MAVLINK_RADIO_STATUS_PERIOD_MS      1000
+
+//system and component id used by SiK radios ('3', 'D')
+#define MAVLINK_RADIO_STATUS_SYSID          51
+#define MAVLINK_RADIO_STATUS_COMPID         68
+
+//uplink frame is considered finished if no bytes were fed for this time (stray STX in non-MAVLink stream).
+//Should be longer than gap between ESP-NOW packets, frame can be split between packets.
+#define MAVLINK_RADIO_STATUS_UPLINK_TIMEOUT_MS  200
+
+//RADIO_STATUS wire frame: v1: 6 + 9 + 2, v2: 10 + 9 + 2
+#define MAVLINK_RADIO_STATUS_FRAME_SIZE_MAX 21
+
+//=====================================================================
+//=====================================================================
+//Periodically writes RADIO_STATUS message to flight controller, like SiK telemetry radio does.
+//Ardupilot and INav slow down telemetry streams if txbuf (free space in radio buffer, %) is low.
+//RSSI and noise are sent in SiK units: (dbm + 127) * 1.9.
+//If flight controller port also carries stream from GCS, feed it through onUplinkByte():
+//message is written only between uplink frames.
+//Uplink bytes are forwarded as they arrive, so tracker only follows frame lengths and does not validate CRC:
+//a false frame start delays message until frame length or MAVLINK_RADIO_STATUS_UPLINK_TIMEOUT_MS is passed.
+class HXMavlinkRadioStatus
+{
+private:
+    bool mavlink_v1;
+    uint16_t periodMs;
+    unsigned long lastSendTime;
+
+    uint8_t rssi;
+    uint8_t remrssi;
+    uint8_t noise;
+    uint8_t remnoise;
+    uint8_t txbuf;
+    uint16_t rxerrors;
+
+    //uplink frame tracking
+    bool uplinkV1;
+    uint16_t uplinkCount;
+    uint16_t uplinkLength;
+    unsigned long lastUplinkTime;
+
+    static uint8_t dbmToSiK( uint8_t dbm );
+
+public:
+    HXMavlinkRadioStatus();
+
+    void init( uint16_t periodMs = MAVLINK_RADIO_STATUS_PERIOD_MS, bool mavlink_v1 = false );
+
+    //positive values in dbm, 70 means -70dbm. 0 - unknown.
+    void setRSSIDbm( uint8_t localDbm, uint8_t remoteDbm );
+    void setNoiseFloorDbm( uint8_t localDbm, uint8_t remoteDbm );
+    //fill of outgoing telemetry buffer, 0..100%
+    void setTxBufferFill( uint8_t percent );
+    void setRxErrors( uint16_t count );
+
+    //byte written to flight controller port from other source
+    void onUplinkByte( uint8_t c );
+
+    //returns true if message was written
+    bool loop( HardwareSerial& serial );
+
+    //builds message with next sequence number, returns frame length
+    uint8_t getFrame( uint8_t* buffer );
+};
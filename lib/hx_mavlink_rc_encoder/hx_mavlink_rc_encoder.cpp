@@ -1,6 +1,6 @@
 #include "hx_mavlink_rc_encoder.h"
 
-#include <common/mavlink.h>
+#include "hx_mavlink_common.h"
 
 #if defined(ESP8266)
 #include <esp8266_peri.h>
@@ -15,12 +15,52 @@ HXMavlinkRCEncoder::HXMavlinkRCEncoder()
 
 //=====================================================================
 //=====================================================================
-void HXMavlinkRCEncoder::initChannels()
+//Build frame template with mavlink library once. All channels are 1000.
+void HXMavlinkRCEncoder::buildFrame()
 {
-    for ( int i = 0; i < MAVLINK_RC_CHANNELS_COUNT; i++ )
+    mavlink_message_t msg;
+    mavlink_msg_rc_channels_override_pack( 
+            1 , MAV_COMP_ID_USER1, 
+            &msg,
+            1, MAV_COMP_ID_AUTOPILOT1,
+            1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,
+            1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,
+            0, 0
+         );
+
+    if ( this->mavlink_v1 )
     {
-        this->channels[i] = 1000;
+        //pack MAVLINK_STATUS_FLAG_OUT_MAVLINK1 flag and recalculate CRC
+        mavlink_status_t* status = mavlink_get_channel_status(MAVLINK_COMM_0);
+        uint8_t flags = status->flags;
+        status->flags = MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+
+        mavlink_finalize_message_chan(
+            &msg, 1, MAV_COMP_ID_USER1,
+            MAVLINK_COMM_0, 
+            MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_MIN_LEN, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_LEN, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_CRC);
+
+        status->flags = flags;
     }
+
+    this->frameLength = mavlink_msg_to_send_buffer( this->frame, &msg ); //26(v1) or 46(v2)
+    this->payloadOffset = this->mavlink_v1 ? MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 : MAVLINK_NUM_HEADER_BYTES;
+    this->seqOffset = this->mavlink_v1 ? 2 : 4;
+    this->seq = 0;
+}
+
+//=====================================================================
+//=====================================================================
+//set next sequence number and recompute CRC
+void HXMavlinkRCEncoder::finalizeFrame()
+{
+    this->frame[this->seqOffset] = this->seq++;
+
+    uint8_t crcOffset = this->frameLength - MAVLINK_NUM_CHECKSUM_BYTES;
+    uint16_t crc = crc_calculate( this->frame + 1, crcOffset - 1 );
+    crc_accumulate( MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_CRC, &crc );
+    this->frame[crcOffset] = (uint8_t)( crc & 0xff );
+    this->frame[crcOffset + 1] = (uint8_t)( crc >> 8 );
 }
 
 //=====================================================================
@@ -30,52 +70,35 @@ void HXMavlinkRCEncoder::init( uint16_t packetRateMS, bool mavlink_v1 )
     this->mavlink_v1 = mavlink_v1;
     this->packetRateMS = packetRateMS;
 
-    this->initChannels();
+    this->buildFrame();
     
     this->lastPacketTime = millis();
     this->failsafe = true;
 }
 
+//=====================================================================
+//=====================================================================
+uint8_t HXMavlinkRCEncoder::getFrame( uint8_t* buffer )
+{
+    finalizeFrame();
+    memcpy( buffer, this->frame, this->frameLength );
+    return this->frameLength;
+}
+
 //=====================================================================
 //=====================================================================
 bool HXMavlinkRCEncoder::loop( HardwareSerial& serial )
 {
-    if (serial.availableForWrite() < 34 ) return false;
+    if (serial.availableForWrite() < this->frameLength ) return false;
 
     unsigned long t = millis();
     if ( (t - this->lastPacketTime)  < this->packetRateMS ) return false;
 
     if ( this->failsafe ) return false;
 
-    mavlink_message_t msg;
-    mavlink_msg_rc_channels_override_pack( 
-            1 , MAV_COMP_ID_USER1, 
-            &msg,
-            1, MAV_COMP_ID_AUTOPILOT1,
-            this->channels[0], this->channels[1], this->channels[2], this->channels[3],
-            this->channels[4], this->channels[5], this->channels[6], this->channels[7],
-            this->channels[8], this->channels[9], this->channels[10], this->channels[11],
-            this->channels[12], this->channels[13], this->channels[14], this->channels[15],
-            0, 0
-         );
-
-    if ( this->mavlink_v1 )
-    {
-        //pack MAVLINK_STATUS_FLAG_OUT_MAVLINK1 flag and recalculate CRC
-        mavlink_get_channel_status(MAVLINK_COMM_0)->flags = MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
-
-        mavlink_finalize_message_chan(
-            &msg, 1, MAV_COMP_ID_USER1,
-            MAVLINK_COMM_0, 
-            MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_MIN_LEN, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_LEN, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_CRC);
-    }
-
-    uint8_t sbuf[MAVLINK_MAX_PACKET_LEN];
-    int len = mavlink_msg_to_send_buffer(sbuf, &msg); //len = 18(v1) or 34(v2)  
-
-    if (serial.availableForWrite() < len ) return false;
+    finalizeFrame();
 
-    serial.write( sbuf, len );
+    serial.write( this->frame, this->frameLength );
 
     this->lastPacketTime = t;
 
@@ -92,11 +115,24 @@ void HXMavlinkRCEncoder::setFailsafe( bool failsafe )
 //=====================================================================
 //=====================================================================
 //input value is in range 1000..2000
+//Value is written to frame payload: chan1..8 raw are at offset 0, chan9..16 raw after target system/component
 void HXMavlinkRCEncoder::setChannelValue( uint8_t index, uint16_t value ) 
 {
-    if ( index < MAVLINK_RC_CHANNELS_COUNT )
+    uint8_t offset;
+    if ( index < MAVLINK_RC_CHANNELS_COUNT_V1 )
     {
-        this->channels[index] = value;
+        offset = index * 2;
+    }
+    else if ( !this->mavlink_v1 && ( index < MAVLINK_RC_CHANNELS_COUNT ) )
+    {
+        offset = 18 + ( index - MAVLINK_RC_CHANNELS_COUNT_V1 ) * 2;
+    }
+    else
+    {
+        return;
     }
-}
 
+    uint8_t* p = this->frame + this->payloadOffset + offset;
+    p[0] = (uint8_t)( value & 0xff );
+    p[1] = (uint8_t)( value >> 8 );
+}
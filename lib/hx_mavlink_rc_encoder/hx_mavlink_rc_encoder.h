@@ -6,18 +6,30 @@
 #define MAVLINK_RC_CHANNELS_COUNT_V1        8 //Mavlink v1 can handle 8 channels only      
 #define MAVLINK_RC_CHANNELS_COUNT           16
 
+//RC_CHANNELS_OVERRIDE wire frame: v1: 6 + 18 + 2, v2: 10 + 34 + 2 (chan17/18 are 0 and are trimmed)
+#define MAVLINK_RC_FRAME_SIZE_MAX           46
+
 //=====================================================================
 //=====================================================================
+//Keeps prebuilt RC_CHANNELS_OVERRIDE frame in wire format. 
+//Channel values, sequence number and CRC are patched in place, 
+//message is not packed and serialized on each send.
 class HXMavlinkRCEncoder
 {
 private:
     bool mavlink_v1;
     bool failsafe;
     uint16_t packetRateMS;
-    uint16_t channels[MAVLINK_RC_CHANNELS_COUNT];
     unsigned long lastPacketTime;
 
-    void initChannels();
+    uint8_t frame[MAVLINK_RC_FRAME_SIZE_MAX];
+    uint8_t frameLength;
+    uint8_t payloadOffset;
+    uint8_t seqOffset;
+    uint8_t seq;
+
+    void buildFrame();
+    void finalizeFrame();
 
 public:
     HXMavlinkRCEncoder();
@@ -28,7 +40,8 @@ public:
     void setFailsafe( bool failsafe );
     void setChannelValue( uint8_t index, uint16_t value );
     bool loop( HardwareSerial& serial );
-};
-
 
+    //current frame with next sequence number and CRC, returns frame length
+    uint8_t getFrame( uint8_t* buffer );
+};
 
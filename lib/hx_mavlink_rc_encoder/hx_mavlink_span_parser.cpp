@@ -0,0 +1,292 @@
+#include "hx_mavlink_span_parser.h"
+
+//frames are validated against ardupilotmega dialect, which includes all common messages
+#define HX_MAVLINK_DIALECT_ARDUPILOTMEGA
+#include "hx_mavlink_common.h"
+
+//stx, len, seq, sysid, compid, msgid
+#define HEADER_LENGTH_V1    6
+//stx, len, incompat, compat, seq, sysid, compid, msgid[3]
+#define HEADER_LENGTH_V2    10
+
+//=====================================================================
+//=====================================================================
+uint16_t HXMavlinkFrameView::getLength() const
+{
+    return this->length1 + this->length2;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXMavlinkFrameView::getByte( uint16_t index ) const
+{
+    return index < this->length1 ? this->part1[index] : this->part2[index - this->length1];
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkFrameView::copyTo( uint8_t* buffer ) const
+{
+    memcpy( buffer, this->part1, this->length1 );
+    memcpy( buffer + this->length1, this->part2, this->length2 );
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkFrameView::getMessage( mavlink_message_t* msg ) const
+{
+    uint16_t headerLength = this->mavlink1 ? HEADER_LENGTH_V1 : HEADER_LENGTH_V2;
+
+    msg->magic = this->getByte( 0 );
+    msg->len = this->payloadLength;
+    msg->incompat_flags = this->mavlink1 ? 0 : this->getByte( 2 );
+    msg->compat_flags = this->mavlink1 ? 0 : this->getByte( 3 );
+    msg->seq = this->getByte( this->mavlink1 ? 2 : 4 );
+    msg->sysid = this->sysId;
+    msg->compid = this->compId;
+    msg->msgid = this->msgId;
+    msg->checksum = this->getByte( headerLength + this->payloadLength ) | ( this->getByte( headerLength + this->payloadLength + 1 ) << 8 );
+
+    uint8_t* payload = (uint8_t*)_MAV_PAYLOAD_NON_CONST( msg );
+    if ( headerLength + this->payloadLength <= this->length1 )
+    {
+        memcpy( payload, this->part1 + headerLength, this->payloadLength );
+    }
+    else
+    {
+        for ( uint8_t i = 0; i < this->payloadLength; i++ ) payload[i] = this->getByte( headerLength + i );
+    }
+
+    const mavlink_msg_entry_t* e = mavlink_get_msg_entry( this->msgId );
+    if ( e && ( this->payloadLength < e->max_msg_len ) )
+    {
+        memset( payload + this->payloadLength, 0, e->max_msg_len - this->payloadLength );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+HXMavlinkSpanParser::HXMavlinkSpanParser()
+{
+    this->passUnknownMessages = false;
+    this->verifyCRC = true;
+    this->init();
+    this->setInput( NULL, 0 );
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkSpanParser::init()
+{
+    this->framesOk = 0;
+    this->crcErrors = 0;
+    this->headerErrors = 0;
+    this->garbageBytes = 0;
+    this->unknownFrames = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkSpanParser::setPassUnknownMessages( bool pass )
+{
+    this->passUnknownMessages = pass;
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkSpanParser::setInput( const uint8_t* data1, uint16_t length1, const uint8_t* data2, uint16_t length2 )
+{
+    this->data1 = data1;
+    this->length1 = length1;
+    this->data2 = data2;
+    this->length2 = length2;
+
+    this->pos = 0;
+    this->consumed = 0;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXMavlinkSpanParser::getByte( uint16_t index ) const
+{
+    return index < this->length1 ? this->data1[index] : this->data2[index - this->length1];
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkSpanParser::setVerifyCRC( bool verify )
+{
+    this->verifyCRC = verify;
+}
+
+//=====================================================================
+//=====================================================================
+//returns total input length if STX is not found
+uint16_t HXMavlinkSpanParser::findSTX( uint16_t index ) const
+{
+    if ( index < this->length1 )
+    {
+        const uint8_t* p = this->data1 + index;
+        const uint8_t* end = this->data1 + this->length1;
+        while ( ( p < end ) && ( *p != MAVLINK_STX ) && ( *p != MAVLINK_STX_MAVLINK1 ) ) p++;
+        if ( p < end ) return p - this->data1;
+        index = this->length1;
+    }
+
+    const uint8_t* p = this->data2 + ( index - this->length1 );
+    const uint8_t* end = this->data2 + this->length2;
+    while ( ( p < end ) && ( *p != MAVLINK_STX ) && ( *p != MAVLINK_STX_MAVLINK1 ) ) p++;
+    return this->length1 + ( p - this->data2 );
+}
+
+//=====================================================================
+//=====================================================================
+//CRC is calculated over up to two contiguous runs, without per byte span checks
+uint16_t HXMavlinkSpanParser::accumulateCRC( uint16_t index, uint16_t length, uint16_t crc ) const
+{
+    if ( index < this->length1 )
+    {
+        uint16_t run = this->length1 - index;
+        if ( run > length ) run = length;
+        const uint8_t* p = this->data1 + index;
+        for ( uint16_t i = 0; i < run; i++ ) crc_accumulate( p[i], &crc );
+        index += run;
+        length -= run;
+    }
+
+    const uint8_t* p = this->data2 + ( index - this->length1 );
+    for ( uint16_t i = 0; i < length; i++ ) crc_accumulate( p[i], &crc );
+
+    return crc;
+}
+
+//=====================================================================
+//=====================================================================
+void HXMavlinkSpanParser::skip( uint16_t count )
+{
+    this->pos += count;
+    this->garbageBytes += count;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXMavlinkSpanParser::next( HXMavlinkFrameView* frame )
+{
+    uint16_t total = this->length1 + this->length2;
+
+    while ( true )
+    {
+        uint16_t stx = this->findSTX( this->pos );
+        this->skip( stx - this->pos );
+
+        uint16_t remaining = total - this->pos;
+        if ( remaining == 0 )
+        {
+            this->consumed = total;
+            return false;
+        }
+
+        bool mavlink1 = this->getByte( this->pos ) == MAVLINK_STX_MAVLINK1;
+        uint16_t headerLength = mavlink1 ? HEADER_LENGTH_V1 : HEADER_LENGTH_V2;
+
+        //incomplete frame at the end of input
+        if ( remaining < headerLength )
+        {
+            this->consumed = this->pos;
+            return false;
+        }
+
+        uint8_t payloadLength = this->getByte( this->pos + 1 );
+        uint8_t incompatFlags = mavlink1 ? 0 : this->getByte( this->pos + 2 );
+        uint32_t msgId = mavlink1 ?
+            this->getByte( this->pos + 5 ) :
+            this->getByte( this->pos + 7 ) | ( ((uint32_t)this->getByte( this->pos + 8 )) << 8 ) | ( ((uint32_t)this->getByte( this->pos + 9 )) << 16 );
+
+        //header is checked before waiting for the whole frame, so garbage does not stall parser
+        const mavlink_msg_entry_t* e = mavlink_get_msg_entry( msgId );
+        bool known = e != NULL;
+        if ( ( ( incompatFlags & ~MAVLINK_IFLAG_MASK ) != 0 ) || ( !known && !this->passUnknownMessages ) || ( known && ( payloadLength > e->max_msg_len ) ) )
+        {
+            this->headerErrors++;
+            this->skip( 1 );
+            continue;
+        }
+
+        uint16_t frameLength = headerLength + payloadLength + MAVLINK_NUM_CHECKSUM_BYTES +
+            ( ( incompatFlags & MAVLINK_IFLAG_SIGNED ) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0 );
+
+        if ( remaining < frameLength )
+        {
+            this->consumed = this->pos;
+            return false;
+        }
+
+        //trusted input is not checked
+        if ( known && this->verifyCRC )
+        {
+            uint16_t crc;
+            crc_init( &crc );
+            crc = this->accumulateCRC( this->pos + 1, headerLength - 1 + payloadLength, crc );
+            crc_accumulate( e->crc_extra, &crc );
+
+            uint16_t crcIndex = this->pos + headerLength + payloadLength;
+            if ( ( this->getByte( crcIndex ) != ( crc & 0xff ) ) || ( this->getByte( crcIndex + 1 ) != ( crc >> 8 ) ) )
+            {
+                this->crcErrors++;
+                this->skip( 1 );
+                continue;
+            }
+        }
+        else if ( !known && this->verifyCRC && ( remaining > frameLength ) )
+        {
+            //CRC can not be checked: frame should be followed by the next frame
+            uint8_t c = this->getByte( this->pos + frameLength );
+            if ( ( c != MAVLINK_STX ) && ( c != MAVLINK_STX_MAVLINK1 ) )
+            {
+                this->headerErrors++;
+                this->skip( 1 );
+                continue;
+            }
+        }
+
+        if ( this->pos < this->length1 )
+        {
+            frame->part1 = this->data1 + this->pos;
+            frame->length1 = this->length1 - this->pos;
+            if ( frame->length1 > frameLength ) frame->length1 = frameLength;
+        }
+        else
+        {
+            frame->part1 = this->data2 + ( this->pos - this->length1 );
+            frame->length1 = frameLength;
+        }
+        frame->part2 = this->data2;
+        frame->length2 = frameLength - frame->length1;
+
+        frame->mavlink1 = mavlink1;
+        frame->known = known;
+        frame->msgId = msgId;
+        frame->sysId = this->getByte( this->pos + ( mavlink1 ? 3 : 5 ) );
+        frame->compId = this->getByte( this->pos + ( mavlink1 ? 4 : 6 ) );
+        frame->payloadLength = payloadLength;
+
+        this->pos += frameLength;
+        this->consumed = this->pos;
+        if ( known )
+        {
+            this->framesOk++;
+        }
+        else
+        {
+            this->unknownFrames++;
+        }
+        return true;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXMavlinkSpanParser::getConsumed() const
+{
+    return this->consumed;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <mavlink_types.h>
+
+//longest frame: v2 header 10 + payload 255 + crc 2 + signature 13.
+//Input should be able to hold at least this amount of bytes, otherwise parser can not make progress.
+#define HX_MAVLINK_SPAN_PARSER_FRAME_MAX    280
+
+//=====================================================================
+//=====================================================================
+//Whole MAVLink frame (stx...crc[,signature]) located in parser input.
+//Frame is not copied: part1 points into input. If frame wraps around the end of ring buffer,
+//remaining bytes are in part2 (start of second span).
+//View is valid while input memory is not modified.
+class HXMavlinkFrameView
+{
+public:
+    const uint8_t* part1;
+    uint16_t length1;
+    const uint8_t* part2;
+    uint16_t length2;
+
+    bool mavlink1;
+    //message id is in dialect table, CRC is verified unless parser is set to trust input.
+    //False only if parser passes unknown messages.
+    bool known;
+    uint32_t msgId;
+    uint8_t sysId;
+    uint8_t compId;
+    uint8_t payloadLength;
+
+    uint16_t getLength() const;
+    uint8_t getByte( uint16_t index ) const;
+
+    //copy whole frame, buffer should hold getLength() bytes
+    void copyTo( uint8_t* buffer ) const;
+
+    //fill message header and payload. Payload is zero-filled up to max length of message,
+    //so mavlink_msg_xxx_get_...() functions can be used on MAVLink2 trimmed payloads.
+    void getMessage( mavlink_message_t* msg ) const;
+};
+
+//=====================================================================
+//=====================================================================
+//MAVLink v1/v2 parser which works on buffers instead of single bytes.
+//Input is given as one or two spans (two halves of ring buffer).
+//Parser searches for STX, validates header (incompat flags, message id is known, payload length),
+//then checks CRC over contiguous runs of input and returns views of valid frames.
+//Frames with bad CRC are skipped, search continues from next byte after STX.
+//
+//Call setInput(), then next() until it returns false. getConsumed() bytes can then be discarded
+//from the start of input; the rest (incomplete frame at the end) should be kept and given again
+//with more data on next setInput().
+//Only common and ardupilotmega dialect messages are recognized, frames with other message ids are skipped as garbage.
+//With setPassUnknownMessages( true ), frames with other message ids (newer common messages, other dialects)
+//are framed by header length and returned with known == false; their CRC can not be verified.
+//Such frame is accepted only if it ends at the end of input or is followed by STX, so stray STX does not swallow valid frames.
+//With setVerifyCRC( false ), input is trusted to contain frames validated earlier (f.e. by another parser):
+//frames are only split by header length.
+//Signature is not verified.
+class HXMavlinkSpanParser
+{
+private:
+    const uint8_t* data1;
+    uint16_t length1;
+    const uint8_t* data2;
+    uint16_t length2;
+
+    uint16_t pos;
+    uint16_t consumed;
+
+    bool passUnknownMessages;
+    bool verifyCRC;
+
+    uint8_t getByte( uint16_t index ) const;
+    uint16_t findSTX( uint16_t index ) const;
+    uint16_t accumulateCRC( uint16_t index, uint16_t length, uint16_t crc ) const;
+    void skip( uint16_t count );
+
+public:
+    uint32_t framesOk;
+    uint32_t crcErrors;
+    uint32_t headerErrors;
+    uint32_t garbageBytes;
+    uint32_t unknownFrames;
+
+    HXMavlinkSpanParser();
+
+    //reset counters
+    void init();
+
+    void setPassUnknownMessages( bool pass );
+    void setVerifyCRC( bool verify );
+
+    void setInput( const uint8_t* data1, uint16_t length1, const uint8_t* data2 = NULL, uint16_t length2 = 0 );
+
+    //returns false if there are no more complete frames in input
+    bool next( HXMavlinkFrameView* frame );
+
+    //bytes from the start of input which are parsed or skipped
+    uint16_t getConsumed() const;
+};
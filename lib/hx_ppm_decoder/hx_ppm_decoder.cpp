@@ -0,0 +1,167 @@
+#include "hx_ppm_decoder.h"
+
+HXPPMDecoder* HXPPMDecoder::pInstance = NULL;
+
+//=====================================================================
+//=====================================================================
+HXPPMDecoder::HXPPMDecoder()
+{
+}
+
+//=====================================================================
+//=====================================================================
+void IRAM_ATTR HXPPMDecoder::onEdgeISR()
+{
+    HXPPMDecoder* p = HXPPMDecoder::pInstance;
+    uint32_t head = p->edgeHead;
+    p->edgeTimesUs[ head % PPM_EDGE_BUFFER_SIZE ] = micros();
+    p->edgeHead = head + 1;
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMDecoder::init( int gpio, bool invert )
+{
+    this->gpio = gpio;
+
+    this->edgeHead = 0;
+    this->edgeTail = 0;
+    this->edgesOverflow = 0;
+
+    this->parser.reset();
+    this->lastFrameCounter = 0;
+    this->lastFrameTime = millis() - PPM_SYNC_FAILSAFE_MS;
+    this->failsafeCount = 0;
+    this->failsafeState = true;
+
+    pInstance = this;
+
+    pinMode( gpio, INPUT );
+    attachInterrupt( digitalPinToInterrupt( gpio ), onEdgeISR, invert ? FALLING : RISING );
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMDecoder::loop()
+{
+    uint32_t head = this->edgeHead;
+
+    if ( ( head - this->edgeTail ) > PPM_EDGE_BUFFER_SIZE )
+    {
+        //ISR has overwritten unprocessed edges
+        this->edgesOverflow += head - this->edgeTail - PPM_EDGE_BUFFER_SIZE;
+        this->edgeTail = head - PPM_EDGE_BUFFER_SIZE;
+        this->parser.resync();
+    }
+
+    while ( this->edgeTail != head )
+    {
+        this->parser.onEdge( this->edgeTimesUs[ this->edgeTail % PPM_EDGE_BUFFER_SIZE ] );
+        this->edgeTail++;
+    }
+
+    if ( this->lastFrameCounter != this->parser.getFrameCounter() )
+    {
+        this->lastFrameCounter = this->parser.getFrameCounter();
+        this->lastFrameTime = millis();
+    }
+
+    updateFailsafe();
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMDecoder::updateFailsafe()
+{
+    bool res = ( millis() - this->lastFrameTime ) >= PPM_SYNC_FAILSAFE_MS;
+
+    if ( !this->failsafeState && res )
+    {
+        this->failsafeCount++;
+    }
+
+    this->failsafeState = res;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXPPMDecoder::getChannelValue( uint8_t index ) const
+{
+    if ( index >= this->parser.getChannelsCount() ) return 1000;
+    return constrain( this->parser.getChannelValue( index ), 1000, 2000 );
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXPPMDecoder::getChannelValueInRange( uint8_t index, uint16_t from, uint16_t to ) const
+{
+    return map( this->getChannelValue( index ), 1000, 2000, from, to );
+}
+
+//=====================================================================
+//=====================================================================
+bool HXPPMDecoder::isOutOfSync() const
+{
+    return !this->parser.isSynced();
+}
+
+//=====================================================================
+//=====================================================================
+bool HXPPMDecoder::isFailsafe() const
+{
+    return this->failsafeState;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXPPMDecoder::getFrameCounter() const
+{
+    return this->lastFrameCounter;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXPPMDecoder::getFrameTimeUs() const
+{
+    return this->parser.getFrameTimeUs();
+}
+
+//=====================================================================
+//=====================================================================
+const HXPPMEdgeParser& HXPPMDecoder::getParser() const
+{
+    return this->parser;
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMDecoder::dump() const
+{
+    Serial.print("Failsafe: ");
+    Serial.print(this->isFailsafe()?1: 0);
+    Serial.print(" (");
+    Serial.print(this->failsafeCount);
+    Serial.println(")");
+
+    Serial.print("OutOfSync:");
+    Serial.println(this->isOutOfSync()?1: 0);
+
+    Serial.print("FramesCount: ");
+    Serial.print(this->parser.framesTotal);
+    Serial.print("  InvalidCount: ");
+    Serial.print(this->parser.framesInvalid);
+    Serial.print("  ChannelsCount: ");
+    Serial.print(this->parser.getChannelsCount());
+    Serial.print("  ChannelsCountChanges: ");
+    Serial.print(this->parser.channelsCountChanges);
+    Serial.print("  EdgesOverflow: ");
+    Serial.println(this->edgesOverflow);
+
+    for ( int i = 0; i < HXPPM_INPUT_MAX_CHANNELS_COUNT; i++ ) 
+    {
+        Serial.print("Channel");
+        Serial.print(i);
+        Serial.print(": ");
+        Serial.println(this->getChannelValue(i));
+    }
+}
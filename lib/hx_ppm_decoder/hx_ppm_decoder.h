@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "hx_ppm_edge_parser.h"
+
+#define PPM_SYNC_FAILSAFE_MS            200
+
+//pulse start timestamps collected by ISR, 2 frames of 16 channels
+#define PPM_EDGE_BUFFER_SIZE            64
+
+//=====================================================================
+//=====================================================================
+//PPM input decoder with the same interface as HXSBUSDecoder.
+//GPIO interrupt timestamps pulse start edges, loop() decodes them.
+//Channel values are updated as soon as channel pulse ends.
+//Only one instance can be used.
+class HXPPMDecoder
+{
+private:
+    static HXPPMDecoder* pInstance;
+
+    int gpio;
+
+    volatile unsigned long edgeTimesUs[PPM_EDGE_BUFFER_SIZE];
+    volatile uint32_t edgeHead;
+    uint32_t edgeTail;
+
+    HXPPMEdgeParser parser;
+    uint32_t lastFrameCounter;
+    unsigned long lastFrameTime;
+    uint16_t failsafeCount;
+    bool failsafeState;
+
+    static void onEdgeISR();
+
+    void updateFailsafe();
+
+public:
+    //edges lost because loop() was not called in time
+    uint32_t edgesOverflow;
+
+    HXPPMDecoder();
+
+    //invert: pulses are low level
+    void init( int gpio, bool invert = false );
+
+    //index 0..15, 1000...2000. Channels which are not present in PPM frame are 1000.
+    uint16_t getChannelValue( uint8_t index ) const;
+    uint16_t getChannelValueInRange( uint8_t index, uint16_t from, uint16_t to ) const;
+    bool isOutOfSync() const;
+    bool isFailsafe() const;
+
+    //incremented on each received frame
+    uint32_t getFrameCounter() const;
+    //micros() when last frame was received
+    unsigned long getFrameTimeUs() const;
+
+    const HXPPMEdgeParser& getParser() const;
+
+    void loop();
+
+    void dump() const;
+};
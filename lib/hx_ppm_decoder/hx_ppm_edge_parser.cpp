@@ -0,0 +1,134 @@
+#include "hx_ppm_edge_parser.h"
+
+//=====================================================================
+//=====================================================================
+HXPPMEdgeParser::HXPPMEdgeParser()
+{
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMEdgeParser::reset()
+{
+    memset( this->channels, 0, sizeof( this->channels ) );
+    this->haveLastEdge = false;
+    this->lastEdgeUs = 0;
+    this->synced = false;
+    this->channelIndex = 0;
+    this->channelsCount = 0;
+    this->framePublished = false;
+    this->frameCounter = 0;
+    this->frameTimeUs = 0;
+
+    this->framesTotal = 0;
+    this->framesInvalid = 0;
+    this->channelsCountChanges = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMEdgeParser::resync()
+{
+    this->haveLastEdge = false;
+    this->synced = false;
+    this->channelIndex = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMEdgeParser::publishFrame( unsigned long timeUs )
+{
+    this->framePublished = true;
+    this->frameTimeUs = timeUs;
+    this->frameCounter++;
+    this->framesTotal++;
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMEdgeParser::onEdge( unsigned long timeUs )
+{
+    if ( !this->haveLastEdge )
+    {
+        this->haveLastEdge = true;
+        this->lastEdgeUs = timeUs;
+        return;
+    }
+
+    unsigned long dt = timeUs - this->lastEdgeUs;
+    this->lastEdgeUs = timeUs;
+
+    if ( dt >= HXPPM_SYNC_MIN_US )
+    {
+        if ( this->synced && ( this->channelIndex >= HXPPM_INPUT_MIN_CHANNELS_COUNT ) && ( this->channelIndex != this->channelsCount ) )
+        {
+            //first frame, or channels count changed: publish on sync gap
+            if ( this->channelsCount != 0 ) this->channelsCountChanges++;
+            this->channelsCount = this->channelIndex;
+            if ( !this->framePublished ) publishFrame( timeUs );
+        }
+        else if ( this->synced && ( this->channelIndex > 0 ) && ( this->channelIndex < HXPPM_INPUT_MIN_CHANNELS_COUNT ) )
+        {
+            this->framesInvalid++;
+        }
+
+        this->synced = true;
+        this->channelIndex = 0;
+        this->framePublished = false;
+        return;
+    }
+
+    if ( !this->synced ) return;
+
+    if ( ( dt < HXPPM_CHANNEL_MIN_US ) || ( dt > HXPPM_CHANNEL_MAX_US ) || ( this->channelIndex >= HXPPM_INPUT_MAX_CHANNELS_COUNT ) )
+    {
+        //glitch: wait for next sync gap
+        this->framesInvalid++;
+        this->synced = false;
+        this->channelIndex = 0;
+        return;
+    }
+
+    this->channels[ this->channelIndex++ ] = dt;
+
+    if ( this->channelIndex == this->channelsCount )
+    {
+        publishFrame( timeUs );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+bool HXPPMEdgeParser::isSynced() const
+{
+    return this->synced && ( this->channelsCount > 0 );
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXPPMEdgeParser::getChannelsCount() const
+{
+    return this->channelsCount;
+}
+
+//=====================================================================
+//=====================================================================
+uint16_t HXPPMEdgeParser::getChannelValue( uint8_t index ) const
+{
+    return index < HXPPM_INPUT_MAX_CHANNELS_COUNT ? this->channels[index] : 0;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXPPMEdgeParser::getFrameCounter() const
+{
+    return this->frameCounter;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXPPMEdgeParser::getFrameTimeUs() const
+{
+    return this->frameTimeUs;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+//Platform independent PPM edge parser. Does not depend on Arduino, can be built on host.
+
+#define HXPPM_INPUT_MAX_CHANNELS_COUNT  16
+#define HXPPM_INPUT_MIN_CHANNELS_COUNT  4
+
+//valid channel slot: pulse start to next pulse start
+#define HXPPM_CHANNEL_MIN_US        700
+#define HXPPM_CHANNEL_MAX_US        2300
+//longer interval is a sync gap
+#define HXPPM_SYNC_MIN_US           3000
+
+//=====================================================================
+//=====================================================================
+//Accepts timestamps of pulse start edges (same polarity).
+//Interval between edges is a value of channel which just ended, it is published immediately.
+//Interval >= HXPPM_SYNC_MIN_US is a sync gap, next edge starts channel 1.
+//Frame is published when number of channels seen in previous frame is reached,
+//so frame does not wait for sync gap. Channels count is learned from sync gaps.
+class HXPPMEdgeParser
+{
+private:
+    uint16_t channels[HXPPM_INPUT_MAX_CHANNELS_COUNT];
+
+    bool haveLastEdge;
+    unsigned long lastEdgeUs;
+
+    //sync gap was seen, channelIndex is valid
+    bool synced;
+    uint8_t channelIndex;
+    //learned from sync gap, 0 - unknown
+    uint8_t channelsCount;
+    bool framePublished;
+
+    uint32_t frameCounter;
+    unsigned long frameTimeUs;
+
+    void publishFrame( unsigned long timeUs );
+
+public:
+    //total published frames
+    uint32_t framesTotal;
+    //intervals out of channel range or too many channels
+    uint32_t framesInvalid;
+    //number of channels between sync gaps changed
+    uint32_t channelsCountChanges;
+
+    HXPPMEdgeParser();
+
+    void reset();
+
+    //timeUs: time of pulse start edge
+    void onEdge( unsigned long timeUs );
+    //edges were lost (ex. edge buffer overflow), wait for next sync gap
+    void resync();
+
+    bool isSynced() const;
+    uint8_t getChannelsCount() const;
+
+    //1000...2000 (not constrained), 0 - no value yet
+    uint16_t getChannelValue( uint8_t index ) const;
+
+    //incremented on each published frame
+    uint32_t getFrameCounter() const;
+    //time of the edge which completed last frame
+    unsigned long getFrameTimeUs() const;
+};
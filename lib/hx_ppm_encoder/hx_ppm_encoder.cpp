@@ -1,14 +1,16 @@
 #include "hx_ppm_encoder.h"
+#include "hx_ppm_frame_builder.h"
 
 #if defined(ESP8266)
 #include <esp8266_peri.h>
 #elif defined(ESP32)
+#include "driver/rmt.h"
 #endif
 
-#define MAX_PPM_CHANNELS_COUNT 16
+#define MAX_PPM_CHANNELS_COUNT HXPPM_MAX_CHANNELS_COUNT
 
-#define PPM_PULSE_LENGTH_US 400
-#define PPM_PAUSE_LENGTH_US 6000  //5000...20000
+#define PPM_PULSE_LENGTH_US HXPPM_PULSE_LENGTH_US
+#define PPM_PAUSE_LENGTH_US HXPPM_PAUSE_LENGTH_US
 
 #if defined(ESP8266)
 
@@ -17,8 +19,20 @@
 
 #elif defined(ESP32)
 
-static hw_timer_t *timer = NULL;
-static portMUX_TYPE timerMux = portMUX_INITIALIZER_UNLOCKED;
+#define PPM_RMT_CHANNEL RMT_CHANNEL_0
+#define PPM_RMT_CLK_DIV 80  //80MHz APB clock / 80 => 1us ticks
+
+//no pulses in failsafe
+#define PPM_FAILSAFE_LENGTH_US 20000
+
+static portMUX_TYPE rmtMux = portMUX_INITIALIZER_UNLOCKED;
+static HXPPMFrameBuilder frameBuilder;
+
+//double buffered frames: frame items + end marker
+static rmt_item32_t rmtItems[2][HXPPM_MAX_ITEMS_COUNT + 1];
+static uint8_t rmtItemsCount[2];
+//rmtItems[outChannelsIndex ^ 1] contains new frame
+static volatile bool rmtFrameReady = false;
 
 #endif
 
@@ -32,7 +46,9 @@ static volatile bool failsafe = true;
 
 static volatile int outChannelsIndex = 0;
 
+#if defined(ESP8266)
 static uint16_t outChannelValues[2][MAX_PPM_CHANNELS_COUNT];
+#endif
 static uint16_t channelValues[MAX_PPM_CHANNELS_COUNT];
 
 //=====================================================================
@@ -110,66 +126,34 @@ void IRAM_ATTR onTimerISR()
 #elif defined(ESP32)
 //=====================================================================
 //=====================================================================
-
-//https://quadmeup.com/how-to-generate-ppm-signal-with-esp32-and-arduino/
-//https://github.com/ps-after-hours/esp32_ppm_output/blob/main/esp32_ppm_output.ino
-void IRAM_ATTR onTimerISR()
+static void fillFailsafeItems( rmt_item32_t* items )
 {
-    static volatile uint8_t ppmState = PPM_STATE_PULSE;
-    static volatile uint8_t ppmChannelIndex = 0;
-    static volatile int usedFrameLengthUS = 0;
+    items[0].level0 = 0;
+    items[0].duration0 = PPM_FAILSAFE_LENGTH_US / 2;
+    items[0].level1 = 0;
+    items[0].duration1 = PPM_FAILSAFE_LENGTH_US / 2;
+    items[1].val = 0;  //end marker
+}
 
-    portENTER_CRITICAL(&timerMux);
+//=====================================================================
+//=====================================================================
+//Called by RMT driver ISR once per frame, when previous frame is sent.
+//Next frame is copied to RMT memory and started, no CPU work per edge.
+static void IRAM_ATTR onRMTTxEnd( rmt_channel_t channel, void* arg )
+{
+    if ( channel != PPM_RMT_CHANNEL ) return;
 
-    switch ( ppmState ) 
+    portENTER_CRITICAL_ISR(&rmtMux);
+    if ( rmtFrameReady )
     {
-    case PPM_STATE_FAILSAFE:
-        if ( !readyFailsafe ) 
-        {
-            ppmState = PPM_STATE_PULSE;
-            outChannelsIndex ^= 1;
-        }
-        timerAlarmWrite(timer,40000, true);   
-        break;
-
-    case PPM_STATE_PULSE:
-        digitalWrite(tx_pin, HIGH);
-        timerAlarmWrite(timer,PPM_PULSE_LENGTH_US, true);   
-        ppmState = PPM_STATE_FILL;
-        break;
-    
-    case PPM_STATE_FILL:
-        digitalWrite(tx_pin, LOW);
-
-        ppmState = PPM_STATE_PULSE;
-
-        if (ppmChannelIndex == channelsCount)
-        {
-            timerAlarmWrite(timer,PPMFrameLengthUS - usedFrameLengthUS, true);   
-      
-            ppmChannelIndex = 0;
-            usedFrameLengthUS = 0;
-
-            if ( readyFailsafe )
-            {
-                ppmState = PPM_STATE_FAILSAFE;
-            }
-            else
-            {
-                outChannelsIndex ^= 1;
-            }
-        }
-        else
-        {
-            uint16_t currentChannelValue = outChannelValues[outChannelsIndex][ppmChannelIndex];
-            timerAlarmWrite(timer,currentChannelValue - PPM_PULSE_LENGTH_US, true);   
-            usedFrameLengthUS += currentChannelValue;
-            ppmChannelIndex++;
-        }
-        break;
+        outChannelsIndex ^= 1;
+        rmtFrameReady = false;
     }
+    int index = outChannelsIndex;
+    portEXIT_CRITICAL_ISR(&rmtMux);
 
-  portEXIT_CRITICAL(&timerMux);
+    rmt_fill_tx_items( PPM_RMT_CHANNEL, rmtItems[index], rmtItemsCount[index], 0 );
+    rmt_tx_start( PPM_RMT_CHANNEL, true );
 }
 #endif
 
@@ -191,8 +175,10 @@ void HXPPMEncoder::init( uint8_t _channelsCount, uint8_t _tx_pin )
 
     for ( int i = 0; i < MAX_PPM_CHANNELS_COUNT; i++)
     {
+#if defined(ESP8266)
         outChannelValues[0][i] = 1000;
         outChannelValues[1][i] = 1000;
+#endif
         channelValues[i] = 1000;
     }
 
@@ -204,10 +190,39 @@ void HXPPMEncoder::init( uint8_t _channelsCount, uint8_t _tx_pin )
     timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE); //TIM_DIV16 => 80 MHz / 16 => 5 MHz or .2 microseconds
     timer1_write(US_TO_TICKS(12000));       
 #elif defined(ESP32)
-    timer = timerBegin(0, 80, true);
-    timerAttachInterrupt(timer, &onTimerISR, true);
-    timerAlarmWrite(timer, 12000, true);
-    timerAlarmEnable(timer);
+    frameBuilder.init( _channelsCount );
+
+    //start in failsafe: low level without pulses
+    for ( int i = 0; i < 2; i++ )
+    {
+        fillFailsafeItems( rmtItems[i] );
+        rmtItemsCount[i] = 2;
+    }
+    outChannelsIndex = 0;
+    rmtFrameReady = false;
+
+    rmt_config_t config;
+    memset( &config, 0, sizeof( config ) );
+    config.rmt_mode = RMT_MODE_TX;
+    config.channel = PPM_RMT_CHANNEL;
+    config.gpio_num = (gpio_num_t)_tx_pin;
+    config.mem_block_num = 1;  //64 items, frame takes up to HXPPM_MAX_ITEMS_COUNT + 1
+    config.clk_div = PPM_RMT_CLK_DIV;
+    config.tx_config.loop_en = false;
+    config.tx_config.carrier_en = false;
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+    if ( ( rmt_config( &config ) != ESP_OK ) || ( rmt_driver_install( PPM_RMT_CHANNEL, 0, 0 ) != ESP_OK ) )
+    {
+        Serial.println("HXRC: Error: Unable to init RMT for PPM output");
+        return;
+    }
+
+    rmt_register_tx_end_callback( onRMTTxEnd, NULL );
+
+    rmt_fill_tx_items( PPM_RMT_CHANNEL, rmtItems[0], rmtItemsCount[0], 0 );
+    rmt_tx_start( PPM_RMT_CHANNEL, true );
 #endif
 
 }
@@ -225,10 +240,7 @@ void IRAM_ATTR HXPPMEncoder::commit()
 {
 
 #if defined(ESP8266)
-    noInterrupts(); 
-#elif defined(ESP32)
-    portENTER_CRITICAL(&timerMux);
-#endif
+  noInterrupts(); 
 
   int p = outChannelsIndex ^ 1;
   for ( int i = 0; i < channelsCount; i++)
@@ -237,10 +249,38 @@ void IRAM_ATTR HXPPMEncoder::commit()
   }
   readyFailsafe = failsafe;
 
-#if defined(ESP8266)
   interrupts(); 
 #elif defined(ESP32)
-  portEXIT_CRITICAL(&timerMux);
+  //build frame outside of critical section
+  rmt_item32_t frame[HXPPM_MAX_ITEMS_COUNT + 1];
+  uint8_t count;
+  if ( failsafe )
+  {
+      fillFailsafeItems( frame );
+      count = 2;
+  }
+  else
+  {
+      HXPPMItem items[HXPPM_MAX_ITEMS_COUNT];
+      count = frameBuilder.build( channelValues, items );
+      for ( int i = 0; i < count; i++ )
+      {
+          frame[i].level0 = 1;
+          frame[i].duration0 = items[i].highUs;
+          frame[i].level1 = 0;
+          frame[i].duration1 = items[i].lowUs;
+      }
+      frame[count++].val = 0;  //end marker
+  }
+
+  //ISR only reads buffer selected by outChannelsIndex
+  portENTER_CRITICAL(&rmtMux);
+  int p = outChannelsIndex ^ 1;
+  memcpy( rmtItems[p], frame, count * sizeof( rmt_item32_t ) );
+  rmtItemsCount[p] = count;
+  readyFailsafe = failsafe;
+  rmtFrameReady = true;
+  portEXIT_CRITICAL(&rmtMux);
 #endif
 
 }
@@ -0,0 +1,54 @@
+#include "hx_ppm_frame_builder.h"
+
+//=====================================================================
+//=====================================================================
+HXPPMFrameBuilder::HXPPMFrameBuilder()
+{
+    this->channelsCount = 8;
+}
+
+//=====================================================================
+//=====================================================================
+void HXPPMFrameBuilder::init( uint8_t channelsCount )
+{
+    if ( channelsCount < 4 ) channelsCount = 4;
+    if ( channelsCount > HXPPM_MAX_CHANNELS_COUNT ) channelsCount = HXPPM_MAX_CHANNELS_COUNT;
+    this->channelsCount = channelsCount;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXPPMFrameBuilder::getChannelsCount() const
+{
+    return this->channelsCount;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXPPMFrameBuilder::getFrameLengthUs() const
+{
+    return (uint32_t)this->channelsCount * 2000 + HXPPM_PAUSE_LENGTH_US + HXPPM_PULSE_LENGTH_US;
+}
+
+//=====================================================================
+//=====================================================================
+uint8_t HXPPMFrameBuilder::build( const uint16_t* channelValues, HXPPMItem* items ) const
+{
+    uint32_t usedUs = 0;
+
+    for ( int i = 0; i < this->channelsCount; i++ )
+    {
+        uint16_t v = channelValues[i];
+        if ( v < 1000 ) v = 1000;
+        if ( v > 2000 ) v = 2000;
+
+        items[i].highUs = HXPPM_PULSE_LENGTH_US;
+        items[i].lowUs = v - HXPPM_PULSE_LENGTH_US;
+        usedUs += v;
+    }
+
+    items[this->channelsCount].highUs = HXPPM_PULSE_LENGTH_US;
+    items[this->channelsCount].lowUs = getFrameLengthUs() - HXPPM_PULSE_LENGTH_US - usedUs;
+
+    return this->channelsCount + 1;
+}
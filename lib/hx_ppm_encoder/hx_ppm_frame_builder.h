@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+//Platform independent PPM frame builder. Does not depend on Arduino, can be built on host.
+
+#define HXPPM_MAX_CHANNELS_COUNT    16
+
+#define HXPPM_PULSE_LENGTH_US       400
+#define HXPPM_PAUSE_LENGTH_US       6000  //5000...20000
+
+//channelsCount pulses + sync pulse
+#define HXPPM_MAX_ITEMS_COUNT       ( HXPPM_MAX_CHANNELS_COUNT + 1 )
+
+//=====================================================================
+//=====================================================================
+//Pulse followed by pause. Pulse start to next pulse start is the channel value.
+typedef struct
+{
+    uint16_t highUs;
+    uint16_t lowUs;
+} HXPPMItem;
+
+//=====================================================================
+//=====================================================================
+//Builds PPM frame as a sequence of pulse/pause pairs:
+//one item per channel, then sync item which pads frame to constant length.
+//Frame length is channelsCount * 2000 + HXPPM_PAUSE_LENGTH_US + HXPPM_PULSE_LENGTH_US, 
+//same as timer ISR implementation.
+class HXPPMFrameBuilder
+{
+private:
+    uint8_t channelsCount;
+
+public:
+    HXPPMFrameBuilder();
+
+    //channelsCount == 4...16
+    void init( uint8_t channelsCount );
+
+    uint8_t getChannelsCount() const;
+    uint32_t getFrameLengthUs() const;
+
+    //channelValues: 1000...2000, values are constrained.
+    //items: HXPPM_MAX_ITEMS_COUNT. Returns number of items.
+    uint8_t build( const uint16_t* channelValues, HXPPMItem* items ) const;
+};
@@ -13,14 +13,28 @@ public:
     //for ModeBase system, values are in range 1000...2000
     //for ModeBase system, channel 15 value is used to select active profile in rc transmitter
     //in rc link, channel 15 is used to send failsafe status ( no sbus pulses in external bay ) from rc transmitter to receiver
-    int16_t channelValue[HXRC_CHANNELS_COUNT];  
+    //channels 16, 17 are digital SBUS channels ch17, ch18: 1000 or 2000
+    int16_t channelValue[HXRC_CHANNELS_COUNT + HXRC_DIGITAL_CHANNELS_COUNT];  
+
+    //input frame counter and micros() when frame was received. Counter is 0 if input does not provide frame events.
+    uint32_t frameCounter;
+    unsigned long frameTimeUs;
+
+    HXChannels()
+    {
+        this->frameCounter = 0;
+        this->frameTimeUs = 0;
+
+        //inputs which do not provide digital channels leave them off
+        for ( int i = HXRC_CHANNELS_COUNT; i < HXRC_CHANNELS_COUNT + HXRC_DIGITAL_CHANNELS_COUNT; i++ ) this->channelValue[i] = 1000;
+    }
 
     void dump()
     {
         Serial.print("Failsafe: ");
         Serial.println(this->isFailsafe?1: 0);
 
-        for ( int i = 0; i < HXRC_CHANNELS_COUNT; i++ ) 
+        for ( int i = 0; i < HXRC_CHANNELS_COUNT + HXRC_DIGITAL_CHANNELS_COUNT; i++ ) 
         {
             Serial.print("Channel");
             Serial.print(i);
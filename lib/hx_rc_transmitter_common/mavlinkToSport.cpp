@@ -0,0 +1,196 @@
+#include "mavlinkToSport.h"
+
+#include "hx_mavlink_common.h"
+
+//=====================================================================
+//=====================================================================
+MavlinkToSport::MavlinkToSport()
+{
+    this->init();
+}
+
+//=====================================================================
+//=====================================================================
+void MavlinkToSport::init()
+{
+    this->bufferStart = 0;
+    this->bufferCount = 0;
+    this->parser.init();
+
+    this->armed = false;
+    this->havePosition = false;
+    this->haveHome = false;
+    this->homeFromFC = false;
+
+    this->messagesTranslated = 0;
+}
+
+//=====================================================================
+//=====================================================================
+void MavlinkToSport::parse( const uint8_t* data, uint16_t len, Smartport* sport )
+{
+    while ( len > 0 )
+    {
+        uint16_t n = MAVLINK_TO_SPORT_BUFFER_SIZE - this->bufferCount;
+        if ( n > len ) n = len;
+        for ( uint16_t i = 0; i < n; i++ )
+        {
+            this->buffer[ ( this->bufferStart + this->bufferCount + i ) % MAVLINK_TO_SPORT_BUFFER_SIZE ] = data[i];
+        }
+        this->bufferCount += n;
+        data += n;
+        len -= n;
+
+        //stored data wraps around the end of buffer
+        uint16_t length1 = MAVLINK_TO_SPORT_BUFFER_SIZE - this->bufferStart;
+        if ( length1 > this->bufferCount ) length1 = this->bufferCount;
+        this->parser.setInput( &this->buffer[this->bufferStart], length1, this->buffer, this->bufferCount - length1 );
+
+        HXMavlinkFrameView frame;
+        while ( this->parser.next( &frame ) )
+        {
+            if ( !isTranslated( frame.msgId ) ) continue;
+            frame.getMessage( &this->msg );
+            this->processMessage( sport );
+        }
+
+        //incomplete frame at the end is kept
+        uint16_t consumed = this->parser.getConsumed();
+        this->bufferStart = ( this->bufferStart + consumed ) % MAVLINK_TO_SPORT_BUFFER_SIZE;
+        this->bufferCount -= consumed;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+bool MavlinkToSport::isTranslated( uint32_t msgId )
+{
+    switch ( msgId )
+    {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+    case MAVLINK_MSG_ID_SYS_STATUS:
+    case MAVLINK_MSG_ID_GPS_RAW_INT:
+    case MAVLINK_MSG_ID_ATTITUDE:
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+    case MAVLINK_MSG_ID_HOME_POSITION:
+        return true;
+    }
+    return false;
+}
+
+//=====================================================================
+//=====================================================================
+void MavlinkToSport::processMessage( Smartport* sport )
+{
+    const mavlink_message_t* m = &this->msg;
+
+    switch ( m->msgid )
+    {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+        {
+            //ignore GCS, gimbal and other non-autopilot components
+            if ( mavlink_msg_heartbeat_get_autopilot( m ) == MAV_AUTOPILOT_INVALID ) return;
+
+            bool armed = ( mavlink_msg_heartbeat_get_base_mode( m ) & MAV_MODE_FLAG_SAFETY_ARMED ) != 0;
+            if ( armed && !this->armed && !this->homeFromFC && this->havePosition )
+            {
+                this->haveHome = true;
+                this->homeLat = this->lat;
+                this->homeLon = this->lon;
+            }
+            this->armed = armed;
+
+            sport->setFlightMode( mavlink_msg_heartbeat_get_custom_mode( m ) * 10 + ( armed ? 1 : 0 ) );
+        }
+        break;
+
+    case MAVLINK_MSG_ID_SYS_STATUS:
+        {
+            //mV => 0.01V
+            sport->setVFAS( mavlink_msg_sys_status_get_voltage_battery( m ) / 10 );
+
+            //10mA, -1: not measured => 0.1A
+            int16_t current = mavlink_msg_sys_status_get_current_battery( m );
+            if ( current >= 0 ) sport->setCurrent( current / 10 );
+
+            //%, -1: not measured
+            int8_t remaining = mavlink_msg_sys_status_get_battery_remaining( m );
+            if ( remaining >= 0 ) sport->setFuel( remaining );
+        }
+        break;
+
+    case MAVLINK_MSG_ID_GPS_RAW_INT:
+        {
+            uint8_t fixType = mavlink_msg_gps_raw_int_get_fix_type( m );
+            uint8_t sats = mavlink_msg_gps_raw_int_get_satellites_visible( m );
+            sport->setGPSState( ( sats == 255 ? 0 : sats ) + ( fixType >= GPS_FIX_TYPE_3D_FIX ? 1000 : 0 ) );
+
+            if ( fixType < GPS_FIX_TYPE_3D_FIX ) return;
+
+            sport->setGPSLatitude( mavlink_msg_gps_raw_int_get_lat( m ) );
+            sport->setGPSLongitude( mavlink_msg_gps_raw_int_get_lon( m ) );
+            //mm => cm
+            sport->setGPSAltitude( mavlink_msg_gps_raw_int_get_alt( m ) / 10 );
+
+            //UINT16_MAX: unknown
+            uint16_t vel = mavlink_msg_gps_raw_int_get_vel( m );
+            if ( vel != UINT16_MAX ) sport->setGPSSpeed( vel );
+            uint16_t cog = mavlink_msg_gps_raw_int_get_cog( m );
+            if ( cog != UINT16_MAX ) sport->setGPSCourse( cog );
+        }
+        break;
+
+    case MAVLINK_MSG_ID_ATTITUDE:
+        {
+            //rad => 0.1 degree
+            sport->setRoll( (int16_t)( mavlink_msg_attitude_get_roll( m ) * ( 1800.0f / PI ) ) );
+            sport->setPitch( (int16_t)( mavlink_msg_attitude_get_pitch( m ) * ( 1800.0f / PI ) ) );
+        }
+        break;
+
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        {
+            //mm => cm
+            sport->setAltitude( (uint32_t)( mavlink_msg_global_position_int_get_relative_alt( m ) / 10 ) );
+            //cm/s, positive down
+            sport->setVario( -mavlink_msg_global_position_int_get_vz( m ) );
+
+            this->lat = mavlink_msg_global_position_int_get_lat( m );
+            this->lon = mavlink_msg_global_position_int_get_lon( m );
+            //0,0 is reported without position estimate
+            this->havePosition = ( this->lat != 0 ) || ( this->lon != 0 );
+            this->updateHomeDistance( sport );
+        }
+        break;
+
+    case MAVLINK_MSG_ID_HOME_POSITION:
+        {
+            this->haveHome = true;
+            this->homeFromFC = true;
+            this->homeLat = mavlink_msg_home_position_get_latitude( m );
+            this->homeLon = mavlink_msg_home_position_get_longitude( m );
+            this->updateHomeDistance( sport );
+        }
+        break;
+
+    default:
+        return;
+    }
+
+    this->messagesTranslated++;
+}
+
+//=====================================================================
+//=====================================================================
+void MavlinkToSport::updateHomeDistance( Smartport* sport )
+{
+    if ( !this->haveHome || !this->havePosition ) return;
+
+    //equirectangular approximation is good enough for RC distances
+    //1E-7 degree = 0.0111319 m
+    float dLat = ( this->lat - this->homeLat ) * 0.0111319f;
+    float dLon = ( this->lon - this->homeLon ) * 0.0111319f * cosf( this->homeLat * ( 1E-7f * PI / 180.0f ) );
+    float d = sqrtf( dLat * dLat + dLon * dLon );
+
+    sport->setHomeDistance( d > 65535.0f ? 65535 : (uint16_t)d );
+}
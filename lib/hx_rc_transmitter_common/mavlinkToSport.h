@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include <mavlink_types.h>
+
+#include "smartport.h"
+#include "hx_mavlink_span_parser.h"
+
+//input ring buffer, should be larger then HX_MAVLINK_SPAN_PARSER_FRAME_MAX
+#define MAVLINK_TO_SPORT_BUFFER_SIZE    512
+
+//=====================================================================
+//=====================================================================
+//Translates MAVLink telemetry stream from receiver into SmartPort sensors:
+//GPS, attitude, battery, altitude, vario, flight mode and home distance.
+//Chunks are collected in ring buffer and parsed with span parser: frames are located and CRC checked in place,
+//only payloads of translated messages are copied. Nothing is allocated.
+//Sensors are updated on reception of corresponding messages:
+//HEARTBEAT, SYS_STATUS, GPS_RAW_INT, ATTITUDE, GLOBAL_POSITION_INT, HOME_POSITION.
+class MavlinkToSport
+{
+private:
+    uint8_t buffer[MAVLINK_TO_SPORT_BUFFER_SIZE];
+    uint16_t bufferStart;
+    uint16_t bufferCount;
+
+    HXMavlinkSpanParser parser;
+    mavlink_message_t msg;
+
+    bool armed;
+
+    bool havePosition;
+    int32_t lat;
+    int32_t lon;
+
+    //HOME_POSITION or position at arming
+    bool haveHome;
+    bool homeFromFC;
+    int32_t homeLat;
+    int32_t homeLon;
+
+    static bool isTranslated( uint32_t msgId );
+    void processMessage( Smartport* sport );
+    void updateHomeDistance( Smartport* sport );
+
+public:
+    uint32_t messagesTranslated;
+
+    MavlinkToSport();
+
+    void init();
+
+    void parse( const uint8_t* data, uint16_t len, Smartport* sport );
+};
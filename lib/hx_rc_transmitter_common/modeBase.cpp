@@ -15,6 +15,7 @@ ModeBase* ModeBase::currentModeHandler;
 
 ModeBase::TModeEventHandler ModeBase::eventHandler = NULL;
 ModeBase::TDataflowEventHandler ModeBase::eventDataFlowHandler = NULL;
+HXCRSFDecoder* ModeBase::crsfDecoder = NULL;
 
 //=====================================================================
 //=====================================================================
@@ -64,7 +65,7 @@ void ModeBase::loop(
 
     if ( sport != NULL )
     {
-        sport->setR9PWR( 20 );
+        sport->setR9PWR( getTXPowerDbm() );
         sport->setProfileId( TXProfileManager::instance.getCurrentProfileIndex()>=0? TXProfileManager::instance.getCurrentProfileIndex() : 255 );
         sport->setDebug1( dt>5000? 5000 : 0 );
 
@@ -184,3 +185,10 @@ void ModeBase::fireDataflowEvent()
         ModeBase::eventDataFlowHandler();
     }
 }
+
+//=====================================================================
+//=====================================================================
+uint8_t ModeBase::getTXPowerDbm()
+{
+    return 20;
+}
@@ -9,6 +9,7 @@
 
 #include "smartport.h"
 #include "HC06Interface.h"
+#include "hx_crsf_decoder.h"
 
 #include "hx_channels.h"
 
@@ -58,6 +59,9 @@ public:
     typedef void (*TDataflowEventHandler) (); 
     static TDataflowEventHandler eventDataFlowHandler;
 
+    //set when radio is connected with CRSF: link statistics and telemetry are sent to radio
+    static HXCRSFDecoder* crsfDecoder;
+
     virtual void start( JsonDocument* json );
 
     virtual void loop(
@@ -78,6 +82,9 @@ public:
     void fire( const char* event );
     void fireDataflowEvent();
 
+    //reported in R9PWR sensor
+    virtual uint8_t getTXPowerDbm();
+
 };
 
 
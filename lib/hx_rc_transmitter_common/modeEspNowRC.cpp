@@ -26,12 +26,28 @@ void ModeEspNowRC::start( JsonDocument* json )
 
     this->LRMode = (*profile)["espnow_long_range_mode"] | false;
 
-    this->hxrcMaster.init(
-        HXRCConfig(
+    HXRCConfig config(
             (*profile)["espnow_channel"] | 3,
             (*profile)["espnow_key"] | 0,
             this->LRMode,
-            -1, false));
+            -1, false);
+    config.adaptiveTxPower = (*profile)["espnow_adaptive_tx_power"] | true;
+    config.packetPeriodMs = (*profile)["espnow_packet_period_ms"] | 0;
+    config.failsafePeriodMs = (*profile)["espnow_failsafe_period_ms"] | DEFAULT_FAILSAFE_PERIOD_MS;
+    config.signalHoldFrames = (*profile)["espnow_signal_hold_frames"] | HXRC_SIGNAL_HOLD_FRAMES_DEFAULT;
+    config.failsafeFrames = (*profile)["espnow_failsafe_frames"] | HXRC_FAILSAFE_FRAMES_DEFAULT;
+    config.telemetryBufferLimit = (*profile)["espnow_telemetry_buffer_limit"] | HXRC_TELEMETRY_BUFFER_SIZE;
+    config.telemetrySizeMax = (*profile)["espnow_telemetry_size_max"] | 0;
+    config.telemetryCompression = (*profile)["espnow_telemetry_compression"] | false;
+    config.mavlinkFrameQueue = (*profile)["espnow_mavlink_frame_queue"] | false;
+    config.telemetryCoalesceMs = (*profile)["espnow_telemetry_coalesce_ms"] | HXRC_TELEMETRY_COALESCE_MS_DEFAULT;
+    config.telemetryCoalesceBytes = (*profile)["espnow_telemetry_coalesce_bytes"] | HXRC_TELEMETRY_COALESCE_BYTES_DEFAULT;
+    config.inputSyncMinIntervalMs = (*profile)["espnow_input_sync_min_interval_ms"] | HXRC_INPUT_SYNC_MIN_INTERVAL_MS_DEFAULT;
+
+    this->hxrcMaster.init( config );
+
+    this->mavlinkToSportEnabled = (*profile)["espnow_mavlink_to_sport"] | false;
+    this->mavlinkToSport.init();
 
     esp_task_wdt_reset();
 
@@ -44,18 +60,66 @@ void ModeEspNowRC::start( JsonDocument* json )
 
         ArduinoOTA.begin();  
     }
+    else if ( (*profile)["espnow_channel_survey"] | false )
+    {
+        //channel can not be changed while AP is running
+        this->hxrcMaster.startChannelSurvey( (*profile)["espnow_channel_survey_dwell_ms"] | HXRC_SURVEY_DEFAULT_DWELL_MS, true );
+    }
 
     esp_task_wdt_reset();
 
     this->lastStats = millis();
     this->lastFailsafe = true;
+    this->lastInputFrameCounter = 0;
 }
 
 
 //=====================================================================
 //=====================================================================
-void ModeEspNowRC::processIncomingTelemetry(HC06Interface* externalBTSerial)
+void ModeEspNowRC::processIncomingTelemetry(HC06Interface* externalBTSerial, Smartport* sport)
 {
+  if ( ModeBase::crsfDecoder != NULL )
+  {
+    //receiver sends CRSF telemetry frames from flight controller
+    uint8_t buffer[64];
+    while ( this->hxrcTelemetrySerial.getAvailable() > 0 )
+    {
+      uint16_t n = 0;
+      while ( ( n < sizeof(buffer) ) && ( this->hxrcTelemetrySerial.getAvailable() > 0 ) )
+      {
+        buffer[n++] = hxrcTelemetrySerial.read();
+      }
+      ModeBase::crsfDecoder->writeTelemetry( buffer, n );
+    }
+    return;
+  }
+
+  if ( this->mavlinkToSportEnabled && ( sport != NULL ) )
+  {
+    //read only as much as fits into bluetooth serial, the rest stays in hxrcTelemetrySerial.
+    //The same bytes are passed to translator and to bluetooth, so stream to GCS is not broken.
+    uint8_t buffer[64];
+    while ( this->hxrcTelemetrySerial.getAvailable() > 0 )
+    {
+      int space = externalBTSerial->availableForWrite();
+      if ( space <= 0 ) break;
+      if ( space > (int)sizeof(buffer) ) space = sizeof(buffer);
+
+      uint16_t n = 0;
+      while ( ( n < space ) && ( this->hxrcTelemetrySerial.getAvailable() > 0 ) )
+      {
+        buffer[n++] = hxrcTelemetrySerial.read();
+      }
+      this->mavlinkToSport.parse( buffer, n, sport );
+
+      for ( uint16_t i = 0; i < n; i++ )
+      {
+        externalBTSerial->write( buffer[i] );
+      }
+    }
+    return;
+  }
+
   while ( this->hxrcTelemetrySerial.getAvailable() > 0 && externalBTSerial->availableForWrite() > 0)
   {
     uint8_t c = hxrcTelemetrySerial.read();
@@ -90,6 +154,12 @@ void ModeEspNowRC::setChannels( const HXChannels* channels )
           //if ( i == 3 ) Serial.println(r);
           hxrcMaster.setChannelValue( i, r );
         }
+
+        //SBUS digital channels ch17, ch18
+        for ( int i = HXRC_CHANNELS_COUNT; i < HXRC_CHANNELS_COUNT + HXRC_DIGITAL_CHANNELS_COUNT; i++ )
+        {
+          hxrcMaster.setChannelValue( i, channels->channelValue[i] );
+        }
     }
 
     //use channel 16 to transmit failsafe flag (SBUS signal lost)
@@ -109,8 +179,14 @@ void ModeEspNowRC::loop(
 
   setChannels(channels);
 
+  if ( this->lastInputFrameCounter != channels->frameCounter )
+  {
+    this->lastInputFrameCounter = channels->frameCounter;
+    hxrcMaster.onInputFrame( channels->frameTimeUs );
+  }
+
   hxrcTelemetrySerial.flushIn();
-  processIncomingTelemetry(externalBTSerial);
+  processIncomingTelemetry(externalBTSerial, sport);
 
   fillOutgoingTelemetry( externalBTSerial);
   hxrcTelemetrySerial.flushOut();
@@ -124,6 +200,16 @@ void ModeEspNowRC::loop(
     hxrcMaster.getTransmitterStats().printStats();
     hxrcMaster.getReceiverStats().printStats();
     if ( channels->isFailsafe) HXRCLOG.print("SBUS FS!\n");
+    if ( ModeBase::crsfDecoder != NULL )
+    {
+      HXRCLOG.printf("CRSF: period:%uus rc:%u replies:%u skipped:%u tlmDropped:%u\n",
+        ModeBase::crsfDecoder->getRCPeriodUs(), ModeBase::crsfDecoder->rcFrames, ModeBase::crsfDecoder->repliesSent,
+        ModeBase::crsfDecoder->repliesSkipped, ModeBase::crsfDecoder->telemetryFramesDropped );
+    }
+    if ( this->mavlinkToSportEnabled )
+    {
+      HXRCLOG.printf("MAVLink->SPORT: %u\n", this->mavlinkToSport.messagesTranslated );
+    }
   }
 
   if ( this->lastFailsafe != hxrcMaster.getReceiverStats().isFailsafe() )
@@ -153,6 +239,22 @@ void ModeEspNowRC::loop(
     sport->loop();
   }
 
+  if ( ModeBase::crsfDecoder != NULL )
+  {
+    HXCRSFLinkStatistics stats;
+    stats.uplinkRSSIAnt1 = hxrcMaster.getReceiverStats().getRemoteRSSIDbm();
+    stats.uplinkRSSIAnt2 = stats.uplinkRSSIAnt1;
+    stats.uplinkLQ = hxrcMaster.getTransmitterStats().getRSSI();
+    stats.uplinkSNR = hxrcMaster.getReceiverStats().getRemoteSNR();
+    stats.activeAntenna = 0;
+    stats.rfMode = 0;
+    stats.uplinkTXPower = HXCRSFPowerFromDbm( getTXPowerDbm() );
+    stats.downlinkRSSI = hxrcMaster.getTransmitterStats().getRSSIDbm();
+    stats.downlinkLQ = hxrcMaster.getReceiverStats().getRSSI();
+    stats.downlinkSNR = hxrcMaster.getTransmitterStats().getSNR();
+    ModeBase::crsfDecoder->setLinkStatistics( stats );
+  }
+
   if ( hxrcMaster.getReceiverStats().isFailsafe() && (*TXProfileManager::instance.getCurrentProfile())["ap_name"].as<const char*>() )
   {
     ArduinoOTA.handle();  
@@ -169,3 +271,10 @@ void ModeEspNowRC::loop(
   }
 
 }
+
+//=====================================================================
+//=====================================================================
+uint8_t ModeEspNowRC::getTXPowerDbm()
+{
+    return this->hxrcMaster.getTxPowerDbm();
+}
@@ -9,6 +9,7 @@
 #include "HX_ESPNOW_RC_SerialBuffer.h"
 
 #include "modeBase.h"
+#include "mavlinkToSport.h"
 
 //=====================================================================
 //=====================================================================
@@ -17,13 +18,17 @@ class ModeEspNowRC : public ModeBase
 private:
     unsigned long lastStats;
     bool lastFailsafe;
+    uint32_t lastInputFrameCounter;
 
     HXRCMaster hxrcMaster;
     HXRCSerialBuffer<512> hxrcTelemetrySerial;
 
+    bool mavlinkToSportEnabled;
+    MavlinkToSport mavlinkToSport;
+
     void setChannels(const HXChannels* channels);
     void fillOutgoingTelemetry(HC06Interface* externalBTSerial);
-    void processIncomingTelemetry(HC06Interface* externalBTSerial);
+    void processIncomingTelemetry(HC06Interface* externalBTSerial, Smartport* sport);
 
 public:
     static ModeEspNowRC instance;
@@ -40,6 +45,8 @@ public:
         HC06Interface* externalBTSerial,
         Smartport* sport
     );
+
+    uint8_t getTXPowerDbm() override;
 };
 
 
@@ -30,31 +30,6 @@ ModeXiroMini::ModeXiroMini()
 
 }
 
-//=====================================================================
-//=====================================================================
-static void ICACHE_RAM_ATTR sniffer_callback(void *buf, wifi_promiscuous_pkt_type_t type)
-{
-    if  (type != WIFI_PKT_MGMT) return;
-
-    static const uint8_t ACTION_SUBTYPE = 0xd0;
-
-    const wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)buf;
-    const wifi_ieee80211_packet_t *ipkt = (wifi_ieee80211_packet_t *)ppkt->payload;
-    const wifi_ieee80211_mac_hdr_t *hdr = &ipkt->hdr;
-
-    if ( 
-        (ACTION_SUBTYPE == (hdr->frame_ctrl & 0xFF) ) &&
-        (memcmp( hdr->addr2, capture.peerMac, 6 ) == 0 )  //mac is first 6 digits
-    )
-    {
-        capture.rssi = ppkt->rx_ctrl.rssi;
-        capture.noiseFloor = ppkt->rx_ctrl.noise_floor;
-        capture.rate = ppkt->rx_ctrl.rate;
-        capture.packetsCount++;
-    }
-}
-
-
 //=====================================================================
 //=====================================================================
 void ModeXiroMini::start( JsonDocument* json )
@@ -94,8 +69,8 @@ void ModeXiroMini::start( JsonDocument* json )
     //udpCMD.begin( IPAddress( 192,168,4,1), UDP_CMD_PORT );
     //udpRTP.begin( UDP_RTP_PORT );
 
-    //esp_wifi_set_promiscuous_rx_cb(&sniffer_callback);
-    //esp_wifi_set_promiscuous(true); 
+    //capture.subscriberId = HXRCSniffer::instance.subscribe( capture.peerMac, HXRC_SNIFFER_SUBTYPE_ACTION, NULL, NULL, true );
+    //HXRCSniffer::instance.start();
 
     this->lastStats = millis();
     this->lastPacketTime = millis();
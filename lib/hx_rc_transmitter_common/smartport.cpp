@@ -72,6 +72,9 @@
 #define FRSKY_SPORT_DIY_DEBUG_1_ID          0x5260
 #define FRSKY_SPORT_DIY_DEBUG_2_ID          0x5261
 #define FRSKY_SPORT_DIY_DEBUG_3_ID          0x5262
+#define FRSKY_SPORT_DIY_DEBUG_4_ID          0x5263
+#define FRSKY_SPORT_DIY_DEBUG_5_ID          0x5264
+#define FRSKY_SPORT_DIY_DEBUG_6_ID          0x5265
 
 #define FRSKY_SPORT_VALID_FRAME_RATE_ID 0xF010  //UNIT_PERCENT displayed as 100-data in OpenTX
 #define FRSKY_SPORT_RSSI_ID             0xf101  //low byte - rssi in dbm, 0x64 = 100dbm
@@ -201,7 +204,7 @@ bool Smartport::findNextValue()
         this->lastSensor++;
         if ( this->lastSensor == SVI_COUNT ) this->lastSensor = 0;
 
-        uint32_t sensorMask = (1<<this->lastSensor);
+        uint64_t sensorMask = ((uint64_t)1)<<this->lastSensor;
         if ( this->setValues & sensorMask ) 
         {
             this->setValues &= ~sensorMask;
@@ -285,6 +288,18 @@ void Smartport::loop()
 	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_24, FRSKY_SPORT_DIY_DEBUG_3_ID, this->values[this->lastSensor]);
             break;
 
+        case SVI_DEBUG_4:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_24, FRSKY_SPORT_DIY_DEBUG_4_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_DEBUG_5:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_24, FRSKY_SPORT_DIY_DEBUG_5_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_DEBUG_6:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_24, FRSKY_SPORT_DIY_DEBUG_6_ID, this->values[this->lastSensor]);
+            break;
+
         case SVI_A1:
 	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_4, FRSKY_SPORT_ADC1_ID, this->values[this->lastSensor]);
             break;
@@ -301,6 +316,55 @@ void Smartport::loop()
 	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_11, FRSKY_SPORT_ALT_ID, this->values[this->lastSensor]);
             break;
 
+        case SVI_VARIO:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_11, FRSKY_SPORT_VARIO_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_GPS_LAT:
+        case SVI_GPS_LON:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_16, FRSKY_SPORT_GPS_LONG_LATI_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_GPS_ALT:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_16, FRSKY_SPORT_GPS_ALT_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_GPS_SPEED:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_16, FRSKY_SPORT_GPS_SPEED_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_GPS_COURSE:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_16, FRSKY_SPORT_GPS_COURS_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_GPS_STATE:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_16, FRSKY_SPORT_T2_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_HOME_DIST:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_16, FRSKY_SPORT_HOME_DIST, this->values[this->lastSensor]);
+            break;
+
+        case SVI_FLIGHT_MODE:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_10, FRSKY_SPORT_T1_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_PITCH:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_10, FRSKY_SPORT_PITCH, this->values[this->lastSensor]);
+            break;
+
+        case SVI_ROLL:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_10, FRSKY_SPORT_ROLL, this->values[this->lastSensor]);
+            break;
+
+        case SVI_CURRENT:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_4, FRSKY_SPORT_CURR_ID, this->values[this->lastSensor]);
+            break;
+
+        case SVI_FUEL:
+	        this->sendDeviceValue(FRSKY_SPORT_DEVICE_4, FRSKY_SPORT_FUEL_ID, this->values[this->lastSensor]);
+            break;
+
         }
     }
 }
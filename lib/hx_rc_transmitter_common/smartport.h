@@ -20,7 +20,23 @@
 #define SVI_DEBUG_1             15
 #define SVI_DEBUG_2             16
 #define SVI_DEBUG_3             17  
-#define SVI_COUNT               18
+#define SVI_DEBUG_4             18
+#define SVI_DEBUG_5             19
+#define SVI_DEBUG_6             20
+#define SVI_GPS_LAT             21
+#define SVI_GPS_LON             22
+#define SVI_GPS_ALT             23
+#define SVI_GPS_SPEED           24
+#define SVI_GPS_COURSE          25
+#define SVI_GPS_STATE           26
+#define SVI_FLIGHT_MODE         27
+#define SVI_HOME_DIST           28
+#define SVI_PITCH               29
+#define SVI_ROLL                30
+#define SVI_CURRENT             31
+#define SVI_FUEL                32
+#define SVI_VARIO               33
+#define SVI_COUNT               34
 
 //=====================================================================
 //=====================================================================
@@ -37,7 +53,7 @@ private:
     unsigned long lastSend;
     uint8_t lastSensor;
 
-    uint32_t setValues;
+    uint64_t setValues;
     uint32_t values[SVI_COUNT];
 
     unsigned short crc;
@@ -60,7 +76,7 @@ public:
     void setSportValue(uint8_t id, uint32_t value)
     {
         this->values[id] = value;
-        this->setValues |= 1<<id;
+        this->setValues |= ((uint64_t)1)<<id;
     }
     
     //Opentx: RSSI, Db, precision 1
@@ -189,5 +205,117 @@ public:
         this->setSportValue(SVI_DEBUG_3, value);
     }  
 
+    //5263
+    void setDebug4( uint32_t value)
+    {
+        this->setSportValue(SVI_DEBUG_4, value);
+    }  
+
+    //5264
+    void setDebug5( uint32_t value)
+    {
+        this->setSportValue(SVI_DEBUG_5, value);
+    }  
+
+    //5265
+    void setDebug6( uint32_t value)
+    {
+        this->setSportValue(SVI_DEBUG_6, value);
+    }  
+
+    //GPS latitude, degrees * 1E7
+    void setGPSLatitude( int32_t value)
+    {
+        this->setSportValue(SVI_GPS_LAT, encodeGPSCoordinate(value, true));
+    }  
+
+    //GPS longitude, degrees * 1E7
+    void setGPSLongitude( int32_t value)
+    {
+        this->setSportValue(SVI_GPS_LON, encodeGPSCoordinate(value, false));
+    }  
+
+    //GPS altitude MSL, meters, precision 2
+    //100=>1m
+    void setGPSAltitude( int32_t value)
+    {
+        this->setSportValue(SVI_GPS_ALT, (uint32_t)value);
+    }  
+
+    //GPS ground speed, knots, precision 3
+    //input value: cm/s
+    void setGPSSpeed( uint16_t value)
+    {
+        this->setSportValue(SVI_GPS_SPEED, ((uint32_t)value) * 1944 / 100);
+    }  
+
+    //GPS course, degrees, precision 2
+    //100=>1 degree
+    void setGPSCourse( uint16_t value)
+    {
+        this->setSportValue(SVI_GPS_COURSE, value);
+    }  
+
+    //Tmp2: number of satellites + 1000 if 3D fix
+    void setGPSState( uint16_t value)
+    {
+        this->setSportValue(SVI_GPS_STATE, value);
+    }  
+
+    //Tmp1: flight mode * 10 + 1 if armed
+    void setFlightMode( uint32_t value)
+    {
+        this->setSportValue(SVI_FLIGHT_MODE, value);
+    }  
+
+    //Distance to home, meters
+    void setHomeDistance( uint16_t value)
+    {
+        this->setSportValue(SVI_HOME_DIST, value);
+    }  
+
+    //Pitch, degrees, precision 1
+    //10=>1 degree
+    void setPitch( int16_t value)
+    {
+        this->setSportValue(SVI_PITCH, (uint32_t)(int32_t)value);
+    }  
+
+    //Roll, degrees, precision 1
+    //10=>1 degree
+    void setRoll( int16_t value)
+    {
+        this->setSportValue(SVI_ROLL, (uint32_t)(int32_t)value);
+    }  
+
+    //Current, A, precision 1
+    //10=>1A
+    void setCurrent( uint16_t value)
+    {
+        this->setSportValue(SVI_CURRENT, value);
+    }  
+
+    //Fuel, battery remaining %
+    void setFuel( uint8_t value)
+    {
+        this->setSportValue(SVI_FUEL, value);
+    }  
+
+    //Vertical speed, m/s, precision 2
+    //100=>1m/s
+    void setVario( int16_t value)
+    {
+        this->setSportValue(SVI_VARIO, (uint32_t)(int32_t)value);
+    }  
+
+    //degrees * 1E7 => 1/10000 minute, bit 31: longitude, bit 30: negative
+    static uint32_t encodeGPSCoordinate( int32_t value, bool latitude )
+    {
+        uint32_t res = ((uint32_t)abs(value)) / 100 * 6;
+        if ( !latitude ) res |= 0x80000000;
+        if ( value < 0 ) res |= 0x40000000;
+        return res;
+    }
+
 };
 
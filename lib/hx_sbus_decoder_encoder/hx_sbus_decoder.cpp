@@ -1,6 +1,5 @@
 #include "hx_sbus_decoder.h"
 
-#define SYNC_COUNT  5
 //=====================================================================
 //=====================================================================
 HXSBUSDecoder::HXSBUSDecoder()
@@ -9,138 +8,145 @@ HXSBUSDecoder::HXSBUSDecoder()
 
 //=====================================================================
 //=====================================================================
-void HXSBUSDecoder::init(int gpio )
+void HXSBUSDecoder::init(int gpio, uint32_t baudrate )
 {
     lastPacket.init();
     lastPacket.failsafe = 1;
     lastPacketTime = millis();
+    lastPacketTimeUs = micros();
 
 #if defined(ESP8266)
-    Serial1.begin(100000, SERIAL_8E2, SerialMode::SERIAL_RX_ONLY, gpio, false );  
+    Serial1.begin(baudrate, SERIAL_8E2, SerialMode::SERIAL_RX_ONLY, gpio, false );  
 #elif defined (ESP32)
-    Serial1.begin(100000, SERIAL_8E2, gpio, -1, false );  
+    Serial1.begin(baudrate, SERIAL_8E2, gpio, -1, false );  
 #endif
 
     pinMode(gpio,INPUT);
 
-    state = 40;
-    syncCount = 0;
-    packetsCount = 0;
-    resyncSkipCount = 0;
-    resyncCount = 0;
+    parser.reset();
+    lastFrameCounter = 0;
     failsafeCount = 0;
     failsafeState = false;
+
+    resetStats();
+}
+
+//=====================================================================
+//=====================================================================
+void HXSBUSDecoder::resetStats()
+{
+    memset( &this->stats, 0, sizeof( this->stats ) );
+    this->lastLoopTimeUs = micros();
+
+    this->windowStartMs = millis();
+    this->windowIntervalSumUs = 0;
+    this->windowIntervalCount = 0;
+    this->windowIntervalMinUs = 0xffffffff;
+    this->windowIntervalMaxUs = 0;
+    this->windowLoopIntervalMaxUs = 0;
 }
 
 //=====================================================================
 //=====================================================================
 void HXSBUSDecoder::loop()
 {
-    bool reuse = false;
-    uint8_t incomingByte;
-    while (Serial1.available() > 0 || reuse) 
-    {
-        if ( !reuse ) incomingByte = Serial1.read();
-        reuse = false;
+    uint8_t buffer[SBUS_READ_BLOCK_SIZE];
 
-        uint8_t* pNext = ((uint8_t*)&packet) + state;
+    unsigned long loopTimeUs = micros();
+    unsigned long dt = loopTimeUs - this->lastLoopTimeUs;
+    this->lastLoopTimeUs = loopTimeUs;
+    if ( this->windowLoopIntervalMaxUs < dt ) this->windowLoopIntervalMaxUs = dt;
 
-        if ( state == 40 )  //sync to the packet end
+    while ( true )
+    {
+        int n = Serial1.available();
+        if ( n <= 0 ) 
         {
-            if ( incomingByte == SBUS_FOOTER )
-            {
-                state = 0;
-                syncCount = 0;
-            }
+            //let parser detect inter-frame gap
+            this->parser.push( NULL, 0, micros() );
+            break;
         }
-        else if ( state >= 30 )  //skip bytes for resync
-        {
-            state++;
-        } 
-        else if ( state == 0 )  //expect packet start
-        {
-            if ( incomingByte == SBUS_HEADER )
-            {
-                /*
-                for ( int i = 0; i < SBUS_PACKET_SIZE; i++ ) 
-                {
-                    Serial.print(Serial1.read(), HEX);
-                    Serial.print( " ");
-                }
-                Serial.println("");
-
-                delay(200);
-                */
+        if ( n > SBUS_READ_BLOCK_SIZE ) n = SBUS_READ_BLOCK_SIZE;
+        n = Serial1.readBytes( buffer, n );
+        this->parser.push( buffer, n, micros() );
+    }
 
+    if ( this->lastFrameCounter != this->parser.getFrameCounter() )
+    {
+        uint32_t count = this->parser.getFrameCounter() - this->lastFrameCounter;
+        this->lastFrameCounter = this->parser.getFrameCounter();
+        memcpy( &this->lastPacket, this->parser.getFrame(), SBUS_PACKET_SIZE );
+        this->lastPacketTime = millis();
+        onFrame( count, this->parser.getFrameTimeUs() );
+    }
 
-                *pNext = incomingByte;
-                state++;
+    updateFailsafe();
+    updateStats( loopTimeUs );
+}
 
+//=====================================================================
+//=====================================================================
+//count: number of frames published by parser since last loop()
+void HXSBUSDecoder::onFrame( uint32_t count, unsigned long timeUs )
+{
+    if ( this->lastPacket.frameLost ) this->stats.framesLost++;
+    if ( this->lastPacket.failsafe ) this->stats.framesFailsafe++;
 
+    if ( count > 1 )
+    {
+        //interval spans multiple frames, do not add to histogram
+        this->stats.framesMissedByLoop += count - 1;
+    }
+    else if ( this->lastFrameCounter > 1 )
+    {
+        unsigned long interval = timeUs - this->lastPacketTimeUs;
 
-            }
-            else
-            {
-                reuse = true;
-                resync();
-            }
-        }
-        else if ( state == (SBUS_PACKET_SIZE-1)  )  //expect footer
-        {
-            if ( incomingByte == SBUS_FOOTER )
-            {
-                *pNext = incomingByte;
-                state++;
-            }
-            else
-            {
-                reuse = true;
-                resync();
-            }
-        }
-        else if ( state == SBUS_PACKET_SIZE  )  //check if next packet starts as expected
-        {
-            if ( incomingByte == SBUS_HEADER ) //next packet started as expected
-            {
-                packetsCount++;
-                if ( syncCount == SYNC_COUNT ) //get good sync ( at least 5 packets) before using data
-                {
-                    parsePacket();
-                    state = 1;  
-                }
-                else
-                {
-                    syncCount++;
-                    state = 1;
-                }
-            }
-            else
-            {
-                resync();
-            }
+        uint32_t bin = interval / SBUS_INTERVAL_HISTOGRAM_BIN_US;
+        if ( bin >= SBUS_INTERVAL_HISTOGRAM_BINS ) bin = SBUS_INTERVAL_HISTOGRAM_BINS - 1;
+        this->stats.intervalHistogram[bin]++;
 
-        }
-        else
-        {
-            //receive packet body
-            *pNext = incomingByte;
-            state++;
-        }
+        this->windowIntervalSumUs += interval;
+        this->windowIntervalCount++;
+        if ( this->windowIntervalMinUs > interval ) this->windowIntervalMinUs = interval;
+        if ( this->windowIntervalMaxUs < interval ) this->windowIntervalMaxUs = interval;
     }
 
-    updateFailsafe();
+    this->lastPacketTimeUs = timeUs;
+
+    this->stats.frameTimesUs[ this->stats.frameTimesIndex ] = timeUs;
+    this->stats.frameTimesIndex = ( this->stats.frameTimesIndex + 1 ) % SBUS_FRAME_TIMES_COUNT;
 }
 
 //=====================================================================
 //=====================================================================
-void HXSBUSDecoder::parsePacket()
+void HXSBUSDecoder::updateStats( unsigned long timeUs )
 {
-    this->lastPacket = packet;
-    this->lastPacketTime = millis();
+    this->stats.framesTotal = this->parser.framesTotal;
+    this->stats.framesInvalid = this->parser.framesInvalid;
+    this->stats.bytesSkipped = this->parser.bytesSkipped;
+    this->stats.gapResyncs = this->parser.gapResyncs;
 
-          //dump();
-          //delay(200);
+    unsigned long t = millis();
+    if ( ( t - this->windowStartMs ) < SBUS_STATS_WINDOW_MS ) return;
+    this->windowStartMs = t;
+
+    this->stats.intervalAvgUs = this->windowIntervalCount > 0 ? this->windowIntervalSumUs / this->windowIntervalCount : 0;
+    this->stats.intervalMinUs = this->windowIntervalCount > 0 ? this->windowIntervalMinUs : 0;
+    this->stats.intervalMaxUs = this->windowIntervalMaxUs;
+    this->stats.loopIntervalMaxUs = this->windowLoopIntervalMaxUs;
+
+    this->windowIntervalSumUs = 0;
+    this->windowIntervalCount = 0;
+    this->windowIntervalMinUs = 0xffffffff;
+    this->windowIntervalMaxUs = 0;
+    this->windowLoopIntervalMaxUs = 0;
+}
 
+//=====================================================================
+//=====================================================================
+const HXSBUSDecoderStats& HXSBUSDecoder::getStats() const
+{
+    return this->stats;
 }
 
 //=====================================================================
@@ -154,7 +160,7 @@ uint16_t HXSBUSDecoder::getChannelValue( uint8_t index ) const
 //=====================================================================
 bool HXSBUSDecoder::isOutOfSync() const
 {
-    return (this->syncCount < SYNC_COUNT) || this->lastPacket.failsafe;
+    return !this->parser.isSynced() || this->lastPacket.failsafe;
 }
 
 //=====================================================================
@@ -164,6 +170,20 @@ bool HXSBUSDecoder::isFailsafe() const
     return this->failsafeState;
 }
 
+//=====================================================================
+//=====================================================================
+uint32_t HXSBUSDecoder::getFrameCounter() const
+{
+    return this->lastFrameCounter;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXSBUSDecoder::getFrameTimeUs() const
+{
+    return this->lastPacketTimeUs;
+}
+
 //=====================================================================
 //=====================================================================
 void HXSBUSDecoder::updateFailsafe()
@@ -202,9 +222,41 @@ void HXSBUSDecoder::dump() const
     Serial.println(this->isOutOfSync()?1: 0);
 
     Serial.print("PacketsCount: ");
-    Serial.print(this->packetsCount);
-    Serial.print("  ResyncCount: ");
-    Serial.println(this->resyncCount);
+    Serial.print(this->parser.framesTotal);
+    Serial.print("  InvalidCount: ");
+    Serial.print(this->parser.framesInvalid);
+    Serial.print("  SkippedBytes: ");
+    Serial.print(this->parser.bytesSkipped);
+    Serial.print("  GapResyncCount: ");
+    Serial.println(this->parser.gapResyncs);
+
+    Serial.print("LostFrames: ");
+    Serial.print(this->stats.framesLost);
+    Serial.print("  FailsafeFrames: ");
+    Serial.print(this->stats.framesFailsafe);
+    Serial.print("  MissedByLoop: ");
+    Serial.println(this->stats.framesMissedByLoop);
+
+    Serial.print("Interval min/avg/max: ");
+    Serial.print(this->stats.intervalMinUs);
+    Serial.print("/");
+    Serial.print(this->stats.intervalAvgUs);
+    Serial.print("/");
+    Serial.print(this->stats.intervalMaxUs);
+    Serial.print("us  Loop max: ");
+    Serial.print(this->stats.loopIntervalMaxUs);
+    Serial.println("us");
+
+    Serial.print("Interval histogram (ms): ");
+    for ( int i = 0; i < SBUS_INTERVAL_HISTOGRAM_BINS; i++ ) 
+    {
+        if ( this->stats.intervalHistogram[i] == 0 ) continue;
+        Serial.print(i);
+        Serial.print(":");
+        Serial.print(this->stats.intervalHistogram[i]);
+        Serial.print(" ");
+    }
+    Serial.println("");
 
     for ( int i = 0; i < 16; i++ ) 
     {
@@ -220,7 +272,7 @@ void HXSBUSDecoder::dump() const
 //=====================================================================
 void HXSBUSDecoder::dumpPacket() const
 {
-    uint8_t* p = ((uint8_t*)&packet);
+    const uint8_t* p = ((const uint8_t*)&lastPacket);
     for ( int i = 0; i < SBUS_PACKET_SIZE; i++ ) 
     {
         Serial.print(*p++, HEX);
@@ -230,19 +282,13 @@ void HXSBUSDecoder::dumpPacket() const
 }
 
 
-//=====================================================================
-//=====================================================================
-void HXSBUSDecoder::resync()
-{
-    resyncSkipCount++;
-    if ( resyncSkipCount > 10 ) resyncSkipCount  = 0;
-    state = 40 - resyncSkipCount;
-    resyncCount++;
-}
-
 //=====================================================================
 //=====================================================================
 uint16_t HXSBUSDecoder::getChannelValueInRange( uint8_t index, uint16_t from, uint16_t to ) const  
 {
+    if ( index >= 16 ) 
+    {
+        return this->getChannelValue(index) > 1500 ? to : from;
+    }
     return map( constrain( this->getChannelValue(index), SBUS_MIN, SBUS_MAX ), SBUS_MIN, SBUS_MAX, from, to );
 }
\ No newline at end of file
@@ -4,47 +4,102 @@
 #include <stdint.h>
 
 #include "hx_sbus_packet.h"
+#include "hx_sbus_frame_parser.h"
 
 #define SBUS_SYNC_FAILSAFE_MS            200
 
+//UART is drained by blocks of this size
+#define SBUS_READ_BLOCK_SIZE             64
+
+//inter-frame interval histogram: 1ms bins, last bin counts longer intervals
+#define SBUS_INTERVAL_HISTOGRAM_BIN_US   1000
+#define SBUS_INTERVAL_HISTOGRAM_BINS     24
+//arrival timestamps of last frames
+#define SBUS_FRAME_TIMES_COUNT           16
+#define SBUS_STATS_WINDOW_MS             1000
+
+//=====================================================================
+//=====================================================================
+//SBUS input health. Frame times are UART read times, so they include loop() call jitter:
+//compare intervalMaxUs with loopIntervalMaxUs to see if jitter comes from radio or from our loop.
+typedef struct
+{
+    //parser counters
+    uint32_t framesTotal;
+    uint32_t framesInvalid;
+    uint32_t bytesSkipped;
+    uint32_t gapResyncs;
+
+    //frames with frameLost flag set by radio
+    uint32_t framesLost;
+    //frames with failsafe flag set by radio
+    uint32_t framesFailsafe;
+    //frames replaced by newer frame before loop() consumed them
+    uint32_t framesMissedByLoop;
+
+    //arrival timestamps (micros()) of last frames, frameTimesUs[frameTimesIndex] is the oldest
+    unsigned long frameTimesUs[SBUS_FRAME_TIMES_COUNT];
+    uint8_t frameTimesIndex;
+
+    //inter-frame intervals of consecutive frames
+    uint32_t intervalHistogram[SBUS_INTERVAL_HISTOGRAM_BINS];
+
+    //values over last SBUS_STATS_WINDOW_MS
+    unsigned long intervalAvgUs;
+    unsigned long intervalMinUs;
+    unsigned long intervalMaxUs;
+    //max time between loop() calls
+    unsigned long loopIntervalMaxUs;
+} HXSBUSDecoderStats;
+
 //=====================================================================
 //=====================================================================
 class HXSBUSDecoder
 {
 private:
-    //40 - wait for packet footer( sync)
-    //30..39 - skip byte
-    //0 - expect header
-    //1..23 - receive body
-    //24 expect footer
-    //25 expect header
-    uint8_t state;
-    uint8_t syncCount;
-    uint16_t packetsCount;
-    uint8_t resyncCount;
-    uint8_t resyncSkipCount;
+    HXSBUSFrameParser parser;
+    uint32_t lastFrameCounter;
     uint16_t failsafeCount;
     bool failsafeState;
     
-    HXSBUSPacket packet;
     HXSBUSPacket lastPacket;
     unsigned long lastPacketTime;
+    unsigned long lastPacketTimeUs;
+
+    HXSBUSDecoderStats stats;
+    unsigned long lastLoopTimeUs;
+    //current window
+    unsigned long windowStartMs;
+    uint32_t windowIntervalSumUs;
+    uint16_t windowIntervalCount;
+    unsigned long windowIntervalMinUs;
+    unsigned long windowIntervalMaxUs;
+    unsigned long windowLoopIntervalMaxUs;
 
-    void parsePacket();
     void dumpPacket() const;
-    void resync();
     void updateFailsafe();
+    void onFrame( uint32_t count, unsigned long timeUs );
+    void updateStats( unsigned long timeUs );
 
 public:
     HXSBUSDecoder();
 
-    void init( int gpio );
+    void init( int gpio, uint32_t baudrate = SBUS_BAUDRATE );
 
     uint16_t getChannelValue( uint8_t index ) const;
+    //index 16, 17: digital channels, 1000 or 2000
     uint16_t getChannelValueInRange( uint8_t index, uint16_t from, uint16_t to ) const;
     bool isOutOfSync() const;
     bool isFailsafe() const;
 
+    //incremented on each received frame
+    uint32_t getFrameCounter() const;
+    //micros() when last frame was received
+    unsigned long getFrameTimeUs() const;
+
+    const HXSBUSDecoderStats& getStats() const;
+    void resetStats();
+
     void loop();
 
     void dump() const;
@@ -13,11 +13,25 @@ HXSBUSEncoder::HXSBUSEncoder()
 
 //=====================================================================
 //=====================================================================
-void HXSBUSEncoder::init( HardwareSerial& serial, uint8_t tx_pin, bool invert )
+void HXSBUSEncoder::init( HardwareSerial& serial, uint8_t tx_pin, bool invert, uint32_t baudrate, uint8_t periodMs )
 {
     lastPacket.init();
     lastPacket.failsafe = 1;
-    lastPacketTime = millis();
+
+    unsigned long t = micros();
+    periodUs = periodMs * 1000UL;
+    minIntervalUs = SBUS_PACKET_SIZE * 12 * 1000000UL / baudrate + SBUS_MIN_GAP_US;
+    lastFrameTimeUs = t - periodUs;
+    nextFrameTimeUs = t;
+    newData = false;
+    dataTimeUs = t;
+
+    framesEvent = 0;
+    framesTimer = 0;
+    jitterSumUs = 0;
+    jitterMaxUs = 0;
+    ageSumUs = 0;
+    ageMaxUs = 0;
 
 #if defined(ESP8266)
     //FIXME: Arduino library for ESP8266 does not contain code to invert Serial1.
@@ -27,9 +41,9 @@ void HXSBUSEncoder::init( HardwareSerial& serial, uint8_t tx_pin, bool invert )
     {
         serialConfig |= BIT(UCTXI);
     }
-    serial.begin(100000, (SerialConfig)serialConfig, SerialMode::SERIAL_TX_ONLY, tx_pin, !invert );  
+    serial.begin(baudrate, (SerialConfig)serialConfig, SerialMode::SERIAL_TX_ONLY, tx_pin, !invert );  
 #elif defined(ESP32)
-    serial.begin(100000, SERIAL_8E2, -1, tx_pin, !invert );  
+    serial.begin(baudrate, SERIAL_8E2, -1, tx_pin, !invert );  
 #endif
 
 }
@@ -38,14 +52,77 @@ void HXSBUSEncoder::init( HardwareSerial& serial, uint8_t tx_pin, bool invert )
 //=====================================================================
 void HXSBUSEncoder::loop( HardwareSerial& serial )
 {
-    if (serial.availableForWrite() < sizeof( HXSBUSPacket )) return;
+    unsigned long t = micros();
 
-    unsigned long t = millis();
-    if ( (t - this->lastPacketTime)  < SBUS_RATE_MS ) return;
+    bool onEvent = this->newData && ( ( t - this->lastFrameTimeUs ) >= this->minIntervalUs );
+    if ( !onEvent && ( (long)( t - this->nextFrameTimeUs ) < 0 ) ) return;
 
-    this->lastPacketTime = t;
+    if (serial.availableForWrite() < sizeof( HXSBUSPacket )) return;
 
     serial.write( (const uint8_t*)&this->lastPacket, sizeof ( HXSBUSPacket ));
+
+    if ( onEvent )
+    {
+        this->framesEvent++;
+        //rephase cadence to incoming packets
+        this->nextFrameTimeUs = t + this->periodUs;
+    }
+    else
+    {
+        this->framesTimer++;
+        unsigned long jitter = t - this->nextFrameTimeUs;
+        this->jitterSumUs += jitter;
+        if ( this->jitterMaxUs < jitter ) this->jitterMaxUs = jitter;
+
+        this->nextFrameTimeUs += this->periodUs;
+        //do not try to catch up after long stall
+        if ( (long)( t - this->nextFrameTimeUs ) >= 0 ) this->nextFrameTimeUs = t + this->periodUs;
+    }
+
+    unsigned long age = t - this->dataTimeUs;
+    this->ageSumUs += age;
+    if ( this->ageMaxUs < age ) this->ageMaxUs = age;
+
+    this->lastFrameTimeUs = t;
+    this->newData = false;
+}
+
+//=====================================================================
+//=====================================================================
+void HXSBUSEncoder::onChannelsReceived( unsigned long receivedTimeUs )
+{
+    this->newData = true;
+    this->dataTimeUs = receivedTimeUs;
+}
+
+//=====================================================================
+//=====================================================================
+void HXSBUSEncoder::printStats()
+{
+    uint16_t frames = this->framesEvent + this->framesTimer;
+
+    Serial.print("SBUS out: frames: ");
+    Serial.print(frames);
+    Serial.print(" (event/timer ");
+    Serial.print(this->framesEvent);
+    Serial.print("/");
+    Serial.print(this->framesTimer);
+    Serial.print(") | jitter avg/max: ");
+    Serial.print(this->framesTimer > 0 ? (unsigned long)(this->jitterSumUs / this->framesTimer) : 0);
+    Serial.print("/");
+    Serial.print(this->jitterMaxUs);
+    Serial.print("us | data age avg/max: ");
+    Serial.print(frames > 0 ? (unsigned long)(this->ageSumUs / frames) : 0);
+    Serial.print("/");
+    Serial.print(this->ageMaxUs);
+    Serial.println("us");
+
+    this->framesEvent = 0;
+    this->framesTimer = 0;
+    this->jitterSumUs = 0;
+    this->jitterMaxUs = 0;
+    this->ageSumUs = 0;
+    this->ageMaxUs = 0;
 }
 
 //=====================================================================
@@ -55,6 +132,13 @@ void HXSBUSEncoder::setFailsafe( bool failsafe )
     this->lastPacket.failsafe = failsafe?1:0;
 }
 
+//=====================================================================
+//=====================================================================
+void HXSBUSEncoder::setFrameLost( bool frameLost )
+{
+    this->lastPacket.frameLost = frameLost?1:0;
+}
+
 //=====================================================================
 //=====================================================================
 void HXSBUSEncoder::setChannelValueDirect( uint8_t index, uint16_t value )
@@ -67,6 +151,12 @@ void HXSBUSEncoder::setChannelValueDirect( uint8_t index, uint16_t value )
 //input value is in range 1000..2000
 void HXSBUSEncoder::setChannelValue( uint8_t index, uint16_t value ) 
 {
+    if ( index >= 16 )
+    {
+        //digital channels
+        this->lastPacket.setChannelValue( index, value );
+        return;
+    }
     this->lastPacket.setChannelValue( index, constrain( map( value, 1000, 2000, SBUS_MIN, SBUS_MAX), 0, 2047) );
 }
 
@@ -5,8 +5,8 @@
 
 #include "hx_sbus_packet.h"
 
-//write packet every ?ms
-#define SBUS_RATE_MS            15
+//25 bytes, 12 bits each: 3ms at 100000 baud. Keep at least 1ms gap between frames.
+#define SBUS_MIN_GAP_US         1000
 
 //=====================================================================
 //=====================================================================
@@ -14,17 +14,43 @@ class HXSBUSEncoder
 {
 private:
     HXSBUSPacket lastPacket;
-    unsigned long lastPacketTime;
+
+    unsigned long periodUs;
+    unsigned long minIntervalUs;
+    unsigned long lastFrameTimeUs;
+    unsigned long nextFrameTimeUs;
+    bool newData;
+    unsigned long dataTimeUs;
+
+    //stats since last printStats()
+    uint16_t framesEvent;
+    uint16_t framesTimer;
+    uint64_t jitterSumUs;
+    unsigned long jitterMaxUs;
+    uint64_t ageSumUs;
+    unsigned long ageMaxUs;
 
 public:
     HXSBUSEncoder();
 
-    void init( HardwareSerial& serial, uint8_t tx_pin, bool invert );
+    //periodMs: write frame every ?ms if there is no new data
+    void init( HardwareSerial& serial, uint8_t tx_pin, bool invert, uint32_t baudrate = SBUS_BAUDRATE, uint8_t periodMs = SBUS_PERIOD_MS );
 
     void setFailsafe( bool failsafe );
+    void setFrameLost( bool frameLost );
     void setChannelValueDirect( uint8_t index, uint16_t value );
     void setChannelValue( uint8_t index, uint16_t value );
+
+    //new RC frame was received: channel values will be sent as soon as possible.
+    //receivedTimeUs: micros() when data was received, used for data age stats.
+    void onChannelsReceived( unsigned long receivedTimeUs );
+
+    //Frame is sent immediately after onChannelsReceived() (respecting frame time + SBUS_MIN_GAP_US),
+    //otherwise every periodMs counting from the last frame.
+    //Whole frame is written into UART TX FIFO, so byte timing does not depend on loop load.
     void loop( HardwareSerial& serial );
+
+    void printStats();
 };
 
 
@@ -0,0 +1,176 @@
+#include "hx_sbus_frame_parser.h"
+
+//=====================================================================
+//=====================================================================
+HXSBUSFrameParser::HXSBUSFrameParser()
+{
+    reset();
+}
+
+//=====================================================================
+//=====================================================================
+void HXSBUSFrameParser::reset()
+{
+    this->count = 0;
+
+    memset( this->lastFrame, 0, sizeof(this->lastFrame) );
+    this->lastFrameTimeUs = 0;
+    this->frameCounter = 0;
+
+    this->lastDataUs = 0;
+    this->idleGap = false;
+    this->frameStartedAfterGap = false;
+    this->synced = false;
+    this->consecutiveFrames = 0;
+
+    this->framesTotal = 0;
+    this->framesInvalid = 0;
+    this->bytesSkipped = 0;
+    this->gapResyncs = 0;
+}
+
+//=====================================================================
+//=====================================================================
+bool HXSBUSFrameParser::isFooter( uint8_t c )
+{
+    return ( c == HXSBUS_FRAME_FOOTER ) || ( ( c & HXSBUS2_FOOTER_MASK ) == HXSBUS2_FOOTER );
+}
+
+//=====================================================================
+//=====================================================================
+void HXSBUSFrameParser::push( const uint8_t* data, uint16_t len, unsigned long timeUs )
+{
+    if ( len == 0 ) 
+    {
+        if ( ( timeUs - this->lastDataUs ) >= HXSBUS_MIN_GAP_US ) this->idleGap = true;
+        return;
+    }
+
+    bool gap = this->idleGap;
+    this->idleGap = false;
+    this->lastDataUs = timeUs;
+
+    if ( gap )
+    {
+        if ( this->count > 0 )
+        {
+            //frame can not be interrupted by gap
+            this->gapResyncs++;
+            this->count = 0;
+            this->synced = false;
+            this->consecutiveFrames = 0;
+        }
+    }
+
+    uint16_t i = 0;
+    while ( i < len )
+    {
+        if ( this->count == 0 )
+        {
+            const uint8_t* p = (const uint8_t*)memchr( data + i, HXSBUS_FRAME_HEADER, len - i );
+            if ( p == NULL )
+            {
+                this->bytesSkipped += len - i;
+                this->consecutiveFrames = 0;
+                return;
+            }
+
+            uint16_t skip = p - ( data + i );
+            if ( skip > 0 )
+            {
+                this->bytesSkipped += skip;
+                this->consecutiveFrames = 0;
+            }
+            this->frameStartedAfterGap = gap && ( i + skip == 0 );
+            i += skip;
+        }
+
+        uint16_t n = HXSBUS_FRAME_SIZE - this->count;
+        if ( n > len - i ) n = len - i;
+        memcpy( this->frame + this->count, data + i, n );
+        this->count += n;
+        i += n;
+
+        if ( this->count == HXSBUS_FRAME_SIZE )
+        {
+            if ( isFooter( this->frame[HXSBUS_FRAME_SIZE - 1] ) )
+            {
+                onFrameComplete( timeUs );
+                this->count = 0;
+            }
+            else
+            {
+                this->framesInvalid++;
+                resync();
+            }
+        }
+    }
+}
+
+//=====================================================================
+//=====================================================================
+void HXSBUSFrameParser::onFrameComplete( unsigned long timeUs )
+{
+    this->framesTotal++;
+
+    if ( this->consecutiveFrames < 255 ) this->consecutiveFrames++;
+    if ( this->frameStartedAfterGap || ( this->consecutiveFrames >= 2 ) ) this->synced = true;
+
+    if ( this->synced )
+    {
+        memcpy( this->lastFrame, this->frame, HXSBUS_FRAME_SIZE );
+        this->lastFrameTimeUs = timeUs;
+        this->frameCounter++;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+//header was false positive: restart search from the next header inside collected bytes
+void HXSBUSFrameParser::resync()
+{
+    this->synced = false;
+    this->consecutiveFrames = 0;
+    this->frameStartedAfterGap = false;
+
+    const uint8_t* p = (const uint8_t*)memchr( this->frame + 1, HXSBUS_FRAME_HEADER, HXSBUS_FRAME_SIZE - 1 );
+    if ( p == NULL )
+    {
+        this->bytesSkipped += HXSBUS_FRAME_SIZE;
+        this->count = 0;
+        return;
+    }
+
+    uint8_t offset = p - this->frame;
+    this->bytesSkipped += offset;
+    this->count = HXSBUS_FRAME_SIZE - offset;
+    memmove( this->frame, this->frame + offset, this->count );
+}
+
+//=====================================================================
+//=====================================================================
+bool HXSBUSFrameParser::isSynced() const
+{
+    return this->synced;
+}
+
+//=====================================================================
+//=====================================================================
+uint32_t HXSBUSFrameParser::getFrameCounter() const
+{
+    return this->frameCounter;
+}
+
+//=====================================================================
+//=====================================================================
+const uint8_t* HXSBUSFrameParser::getFrame() const
+{
+    return this->lastFrame;
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long HXSBUSFrameParser::getFrameTimeUs() const
+{
+    return this->lastFrameTimeUs;
+}
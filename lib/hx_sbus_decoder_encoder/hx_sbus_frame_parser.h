@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+//Platform independent SBUS frame parser. Does not depend on Arduino, can be built on host.
+
+#define HXSBUS_FRAME_SIZE           25
+#define HXSBUS_FRAME_HEADER         0x0f
+#define HXSBUS_FRAME_FOOTER         0x00
+//SBUS2 telemetry slot footers: 0x04, 0x14, 0x24, 0x34
+#define HXSBUS2_FOOTER_MASK         0xcf
+#define HXSBUS2_FOOTER              0x04
+
+//Frame takes 3ms at 100000 baud 8E2. Frames are sent every 7 or 14 ms.
+//Silence of this time means next byte starts a frame. Byte takes 120us.
+#define HXSBUS_MIN_GAP_US           1000
+
+//=====================================================================
+//=====================================================================
+//Accepts blocks of bytes read from UART with receive timestamp.
+//push() should also be called when UART has no data: inter-frame gap is detected
+//if UART was polled empty at least HXSBUS_MIN_GAP_US after last data.
+//Header is located with memchr(), frame body is copied by blocks.
+//Frame is valid if it starts with header and ends with SBUS or SBUS2 footer.
+//Parser is synced after valid frame which started after inter-frame gap,
+//or after two valid frames back to back. Frames are published only while synced.
+class HXSBUSFrameParser
+{
+private:
+    uint8_t frame[HXSBUS_FRAME_SIZE];
+    uint8_t count;
+
+    uint8_t lastFrame[HXSBUS_FRAME_SIZE];
+    unsigned long lastFrameTimeUs;
+    uint32_t frameCounter;
+
+    unsigned long lastDataUs;
+    bool idleGap;
+    bool frameStartedAfterGap;
+    bool synced;
+    uint8_t consecutiveFrames;
+
+    static bool isFooter( uint8_t c );
+
+    void onFrameComplete( unsigned long timeUs );
+    void resync();
+
+public:
+    //total valid frames
+    uint32_t framesTotal;
+    //frames with invalid footer
+    uint32_t framesInvalid;
+    //bytes skipped while searching for header
+    uint32_t bytesSkipped;
+    //partial frames dropped due to inter-frame gap
+    uint32_t gapResyncs;
+
+    HXSBUSFrameParser();
+
+    void reset();
+
+    //timeUs: time when data was read. len = 0: UART polled, no data available.
+    void push( const uint8_t* data, uint16_t len, unsigned long timeUs );
+
+    bool isSynced() const;
+
+    //incremented on each published frame
+    uint32_t getFrameCounter() const;
+    //last published frame, HXSBUS_FRAME_SIZE bytes
+    const uint8_t* getFrame() const;
+    //time when last byte of the frame was read
+    unsigned long getFrameTimeUs() const;
+};
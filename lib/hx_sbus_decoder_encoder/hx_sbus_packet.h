@@ -7,6 +7,14 @@
 #define SBUS_HEADER         0x0f
 #define SBUS_FOOTER         0x00
 
+#define SBUS_BAUDRATE       100000
+//"fast SBUS", accepted by many flight controllers. Frame takes 1.5ms instead of 3ms.
+#define SBUS_FAST_BAUDRATE  200000
+
+//frame period for normal and high speed mode
+#define SBUS_PERIOD_MS          14
+#define SBUS_FAST_PERIOD_MS     7
+
 #define SBUS_MIN            173
 #define SBUS_DID            992
 #define SBUS_MAX            1811
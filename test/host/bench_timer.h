@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//=====================================================================
+//=====================================================================
+//Wall time and CPU cycles of a measured section.
+//Cycles are TSC ticks on x86 (close to core cycles at nominal frequency), 0 on other hosts.
+class BenchTimer
+{
+private:
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t startCycles;
+
+    static uint64_t getCycles()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+public:
+    double ns;
+    uint64_t cycles;
+
+    BenchTimer() : startCycles( 0 ), ns( 0 ), cycles( 0 ) {}
+
+    void start()
+    {
+        this->startTime = std::chrono::steady_clock::now();
+        this->startCycles = getCycles();
+    }
+
+    void stop()
+    {
+        this->cycles = getCycles() - this->startCycles;
+        this->ns = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - this->startTime ).count();
+    }
+};
@@ -0,0 +1,213 @@
+//Round trip of telemetry streams through HXRCCompressor/HXRCDecompressor.
+//Stream is cut into chunks like HXRCTelemetryStream does: staging buffer is compressed into
+//packet sized chunks, window is reset periodically. Incompressible chunks are sent raw,
+//window advances over them.
+//Prints compression ratio and cycles/byte. Returns 1 if decompressed data differs.
+//
+//Usage: compression_bench [recorded_stream.bin]
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "HX_ESPNOW_RC_TelemetryMux.h"
+#include "telemetry_stream.h"
+#include "bench_timer.h"
+
+//HXRC_SLAVE_TELEMETRY_SIZE_MAX - chunk header
+#define CHUNK_SIZE_MAX          ( 128 - HXRC_STREAM_CHUNK_HEADER_SIZE )
+//HXRC_COMPRESSION_RESYNC_MS at ~57kBit/sec
+#define RESET_PERIOD_BYTES      7000
+#define REPEAT_COUNT            20
+
+//=====================================================================
+//=====================================================================
+class VectorSink : public HXRCRingBufferInterface
+{
+public:
+    std::vector<uint8_t> data;
+
+    bool send( const void* p, uint16_t len )
+    {
+        this->data.insert( this->data.end(), (const uint8_t*)p, (const uint8_t*)p + len );
+        return true;
+    }
+
+    uint16_t receiveUpTo( uint16_t maxLen, uint8_t* toPtr )
+    {
+        return 0;
+    }
+};
+
+//=====================================================================
+//=====================================================================
+//compressed chunks, stored to time decompression separately
+typedef struct
+{
+    bool reset;
+    bool compressed;
+    std::vector<uint8_t> data;
+} Chunk;
+
+//=====================================================================
+//=====================================================================
+static HXRCCompressor compressor;
+static HXRCDecompressor decompressor;
+
+//=====================================================================
+//=====================================================================
+static void compressStream( const std::vector<uint8_t>& stream, std::vector<Chunk>& chunks )
+{
+    size_t pos = 0;
+    size_t sinceReset = RESET_PERIOD_BYTES;
+
+    while ( ( pos < stream.size() ) || ( compressor.stagingCount > 0 ) )
+    {
+        size_t n = stream.size() - pos;
+        if ( n > (size_t)( HXRC_COMPRESSION_STAGING_SIZE - compressor.stagingCount ) ) n = HXRC_COMPRESSION_STAGING_SIZE - compressor.stagingCount;
+        memcpy( compressor.staging + compressor.stagingCount, stream.data() + pos, n );
+        compressor.stagingCount += n;
+        pos += n;
+
+        Chunk chunk;
+        chunk.reset = sinceReset >= RESET_PERIOD_BYTES;
+        if ( chunk.reset )
+        {
+            compressor.reset();
+            sinceReset = 0;
+        }
+
+        uint8_t out[CHUNK_SIZE_MAX];
+        uint16_t consumed;
+        uint16_t len = compressor.compressStaging( out, sizeof( out ), &consumed, &chunk.compressed );
+        chunk.data.assign( out, out + len );
+        chunks.push_back( chunk );
+        sinceReset += consumed;
+    }
+}
+
+//=====================================================================
+//=====================================================================
+static bool decompressStream( const std::vector<Chunk>& chunks, VectorSink& sink )
+{
+    for ( size_t i = 0; i < chunks.size(); i++ )
+    {
+        if ( chunks[i].reset ) decompressor.reset();
+
+        if ( !chunks[i].compressed )
+        {
+            decompressor.append( chunks[i].data.data(), chunks[i].data.size() );
+            sink.send( chunks[i].data.data(), chunks[i].data.size() );
+            continue;
+        }
+
+        bool overflow = false;
+        if ( !decompressor.decompress( chunks[i].data.data(), chunks[i].data.size(), &sink, &overflow ) || overflow ) return false;
+    }
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static bool bench( const char* name, const std::vector<uint8_t>& stream )
+{
+    std::vector<Chunk> chunks;
+    VectorSink sink;
+    BenchTimer compressTimer;
+    BenchTimer decompressTimer;
+    uint64_t compressCycles = UINT64_MAX;
+    uint64_t decompressCycles = UINT64_MAX;
+    double compressNs = 1e30;
+    double decompressNs = 1e30;
+
+    for ( int r = 0; r < REPEAT_COUNT; r++ )
+    {
+        chunks.clear();
+        sink.data.clear();
+        compressor.stagingCount = 0;
+
+        compressTimer.start();
+        compressStream( stream, chunks );
+        compressTimer.stop();
+
+        decompressTimer.start();
+        bool ok = decompressStream( chunks, sink );
+        decompressTimer.stop();
+
+        if ( !ok || ( sink.data != stream ) )
+        {
+            printf( "%s: FAIL: round trip mismatch\n", name );
+            return false;
+        }
+
+        if ( compressTimer.cycles < compressCycles ) compressCycles = compressTimer.cycles;
+        if ( decompressTimer.cycles < decompressCycles ) decompressCycles = decompressTimer.cycles;
+        if ( compressTimer.ns < compressNs ) compressNs = compressTimer.ns;
+        if ( decompressTimer.ns < decompressNs ) decompressNs = decompressTimer.ns;
+    }
+
+    size_t compressedBytes = 0;
+    size_t rawChunks = 0;
+    for ( size_t i = 0; i < chunks.size(); i++ )
+    {
+        compressedBytes += chunks[i].data.size();
+        if ( !chunks[i].compressed ) rawChunks++;
+    }
+
+    //incompressible data is sent raw
+    if ( compressedBytes > stream.size() )
+    {
+        printf( "FAIL: %s: compressed %zu bytes to %zu\n", name, stream.size(), compressedBytes );
+        return false;
+    }
+
+    printf( "%s: %zu bytes, %zu chunks (%zu raw), compressed to %.1f%%\n", name, stream.size(), chunks.size(), rawChunks, 100.0 * compressedBytes / stream.size() );
+    printf( "  compress:   %.2f cycles/byte, %.2f ns/byte\n", (double)compressCycles / stream.size(), compressNs / stream.size() );
+    printf( "  decompress: %.2f cycles/byte, %.2f ns/byte\n", (double)decompressCycles / stream.size(), decompressNs / stream.size() );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+int main( int argc, char** argv )
+{
+    bool ok = true;
+
+    std::vector<uint8_t> stream;
+    if ( argc > 1 )
+    {
+        if ( !loadTelemetryStream( argv[1], stream ) )
+        {
+            printf( "Can not read %s\n", argv[1] );
+            return 1;
+        }
+        ok &= bench( argv[1], stream );
+    }
+    else
+    {
+        generateTelemetryStream( 60, stream );
+        ok &= bench( "MAVLink telemetry (generated)", stream );
+    }
+
+    //worst case: literal runs only
+    std::vector<uint8_t> noise( 50000 );
+    uint32_t seed = 1;
+    for ( size_t i = 0; i < noise.size(); i++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        noise[i] = seed >> 16;
+    }
+    ok &= bench( "random bytes", noise );
+
+    //raw chunks between compressed ones: telemetry interleaved with bursts of random bytes
+    std::vector<uint8_t> mixed;
+    for ( size_t i = 0; i < stream.size(); i += 1000 )
+    {
+        size_t n = stream.size() - i < 1000 ? stream.size() - i : 1000;
+        mixed.insert( mixed.end(), stream.begin() + i, stream.begin() + i + n );
+        mixed.insert( mixed.end(), noise.begin() + i % 40000, noise.begin() + i % 40000 + 200 );
+    }
+    ok &= bench( "telemetry with random bursts", mixed );
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+//Constant time message entry lookup of hx_mavlink_common.h against library bisection search.
+//For common and ardupilotmega dialects, entries must be identical for message ids 0..69999.
+//Timing: parse of telemetry stream with mavlink_frame_char_buffer() (lookup is done for every frame),
+//and lookup alone for message ids in order they appear in stream.
+//
+//Usage: mavlink_lookup_bench [recorded_stream.bin]
+//Returns 1 on mismatch.
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "telemetry_stream.h"
+#include "mavlink_lookup_variant.h"
+#include "bench_timer.h"
+
+#define MSG_ID_CHECK_END    70000
+#define REPEAT_COUNT        20
+
+//=====================================================================
+//=====================================================================
+static bool sameEntry( const mavlink_msg_entry_t* a, const mavlink_msg_entry_t* b )
+{
+    if ( ( a == NULL ) || ( b == NULL ) ) return a == b;
+
+    return ( a->msgid == b->msgid ) && ( a->crc_extra == b->crc_extra ) &&
+        ( a->min_msg_len == b->min_msg_len ) && ( a->max_msg_len == b->max_msg_len ) &&
+        ( a->flags == b->flags ) && ( a->target_system_ofs == b->target_system_ofs ) && ( a->target_component_ofs == b->target_component_ofs );
+}
+
+//=====================================================================
+//=====================================================================
+static bool checkEquivalent( const MavlinkLookupVariant& library, const MavlinkLookupVariant& indexed )
+{
+    uint32_t known = 0;
+    for ( uint32_t id = 0; id < MSG_ID_CHECK_END; id++ )
+    {
+        const mavlink_msg_entry_t* e = library.getMsgEntry( id );
+        if ( !sameEntry( e, indexed.getMsgEntry( id ) ) )
+        {
+            printf( "FAIL: %s and %s differ for msgid %u\n", library.name, indexed.name, id );
+            return false;
+        }
+        if ( e != NULL ) known++;
+    }
+
+    printf( "%s: ids 0..%u identical to %s (%u messages)\n", indexed.name, MSG_ID_CHECK_END - 1, library.name, known );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static bool benchParse( const std::vector<uint8_t>& stream, const MavlinkLookupVariant& library, const MavlinkLookupVariant& indexed )
+{
+    const MavlinkLookupVariant* variants[2] = { &library, &indexed };
+    double ns[2] = { 1e30, 1e30 };
+    uint64_t cycles[2] = { UINT64_MAX, UINT64_MAX };
+    uint32_t frames[2] = { 0, 0 };
+
+    for ( int r = 0; r < REPEAT_COUNT; r++ )
+    {
+        for ( int v = 0; v < 2; v++ )
+        {
+            BenchTimer timer;
+            timer.start();
+            frames[v] = variants[v]->parseStream( stream.data(), stream.size() );
+            timer.stop();
+
+            if ( timer.ns < ns[v] ) ns[v] = timer.ns;
+            if ( timer.cycles < cycles[v] ) cycles[v] = timer.cycles;
+        }
+    }
+
+    if ( frames[0] != frames[1] )
+    {
+        printf( "FAIL: %s parsed %u frames, %s %u\n", library.name, frames[0], indexed.name, frames[1] );
+        return false;
+    }
+
+    printf( "parse %zu bytes, %u frames: %s %.2f ns/byte (%.1f cycles), %s %.2f ns/byte (%.1f cycles)\n",
+        stream.size(), frames[0],
+        library.name, ns[0] / stream.size(), (double)cycles[0] / stream.size(),
+        indexed.name, ns[1] / stream.size(), (double)cycles[1] / stream.size() );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static void benchLookup( const std::vector<uint32_t>& ids, const MavlinkLookupVariant& variant )
+{
+    volatile uintptr_t sink = 0;
+    BenchTimer timer;
+
+    timer.start();
+    for ( int r = 0; r < REPEAT_COUNT; r++ )
+    {
+        for ( size_t i = 0; i < ids.size(); i++ ) sink += (uintptr_t)variant.getMsgEntry( ids[i] );
+    }
+    timer.stop();
+
+    double count = (double)REPEAT_COUNT * ids.size();
+    printf( "lookup of stream message ids: %s %.2f ns (%.1f cycles)\n", variant.name, timer.ns / count, timer.cycles / count );
+}
+
+//=====================================================================
+//=====================================================================
+int main( int argc, char** argv )
+{
+    bool ok = checkEquivalent( commonLibrary, commonIndexed ) && checkEquivalent( ardupilotmegaLibrary, ardupilotmegaIndexed );
+    if ( !ok ) return 1;
+
+    std::vector<uint8_t> stream;
+    if ( argc > 1 )
+    {
+        if ( !loadTelemetryStream( argv[1], stream ) )
+        {
+            printf( "Can not read %s\n", argv[1] );
+            return 1;
+        }
+    }
+    else
+    {
+        generateTelemetryStream( 600, stream );
+    }
+
+    std::vector<uint32_t> ids;
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    memset( &msg, 0, sizeof( msg ) );
+    memset( &status, 0, sizeof( status ) );
+    for ( size_t i = 0; i < stream.size(); i++ )
+    {
+        if ( mavlink_parse_char( MAVLINK_COMM_0, stream[i], &msg, &status ) ) ids.push_back( msg.msgid );
+    }
+
+    ok = benchParse( stream, commonLibrary, commonIndexed ) && benchParse( stream, ardupilotmegaLibrary, ardupilotmegaIndexed );
+
+    benchLookup( ids, commonLibrary );
+    benchLookup( ids, commonIndexed );
+    benchLookup( ids, ardupilotmegaLibrary );
+    benchLookup( ids, ardupilotmegaIndexed );
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+//Built with -DLOOKUP_VARIANT=<name of MavlinkLookupVariant>,
+//-DHX_MAVLINK_LOOKUP to use hx_mavlink_common.h, -DHX_MAVLINK_DIALECT_ARDUPILOTMEGA for ardupilotmega dialect.
+
+#if defined(HX_MAVLINK_LOOKUP)
+#include "hx_mavlink_common.h"
+#elif defined(HX_MAVLINK_DIALECT_ARDUPILOTMEGA)
+#include <ardupilotmega/mavlink.h>
+#else
+#include <common/mavlink.h>
+#endif
+
+#include "mavlink_lookup_variant.h"
+
+#define STRINGIFY_(x) #x
+#define STRINGIFY(x) STRINGIFY_(x)
+
+//=====================================================================
+//=====================================================================
+static const mavlink_msg_entry_t* getMsgEntry( uint32_t msgid )
+{
+    return mavlink_get_msg_entry( msgid );
+}
+
+//=====================================================================
+//=====================================================================
+static uint32_t parseStream( const uint8_t* data, size_t length )
+{
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    memset( &status, 0, sizeof( status ) );
+
+    uint32_t count = 0;
+    for ( size_t i = 0; i < length; i++ )
+    {
+        if ( mavlink_frame_char_buffer( &msg, &status, data[i], NULL, NULL ) == MAVLINK_FRAMING_OK ) count++;
+    }
+    return count;
+}
+
+extern const MavlinkLookupVariant LOOKUP_VARIANT = { STRINGIFY(LOOKUP_VARIANT), getMsgEntry, parseStream };
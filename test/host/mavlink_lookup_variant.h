@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <mavlink_types.h>
+
+//=====================================================================
+//=====================================================================
+//mavlink_get_msg_entry() and parser of one translation unit.
+//mavlink_lookup_variant.cpp is compiled once per dialect with library bisection search
+//and once with hx_mavlink_common.h index table, see Makefile.
+typedef struct
+{
+    const char* name;
+    const mavlink_msg_entry_t* (*getMsgEntry)( uint32_t msgid );
+    //returns number of valid frames, parsed with mavlink_frame_char_buffer()
+    uint32_t (*parseStream)( const uint8_t* data, size_t length );
+} MavlinkLookupVariant;
+
+extern const MavlinkLookupVariant commonLibrary;
+extern const MavlinkLookupVariant commonIndexed;
+extern const MavlinkLookupVariant ardupilotmegaLibrary;
+extern const MavlinkLookupVariant ardupilotmegaIndexed;
@@ -0,0 +1,183 @@
+//HXMavlinkRCEncoder against the mavlink library path it replaces
+//(mavlink_msg_rc_channels_override_pack(), mavlink_finalize_message_chan() for v1, mavlink_msg_to_send_buffer()).
+//Frames must be byte identical for MAVLink v1 and v2 with the same channel values (1000..2000) and sequence number.
+//Values outside of this range must still give valid frames: v2 library frame is trimmed by one more byte
+//if the last channel is below 256, encoder always sends 46 bytes.
+//Prints time per frame of both paths, all 16 channels are updated before every frame.
+//
+//Returns 1 on mismatch.
+
+#include <stdio.h>
+#include <string.h>
+#include <random>
+
+#include "hx_mavlink_common.h"
+#include "hx_mavlink_rc_encoder.h"
+#include "bench_timer.h"
+
+#define CHECK_FRAMES_COUNT      100000
+#define BENCH_FRAMES_COUNT      2000000
+
+//=====================================================================
+//=====================================================================
+//frame as it was built before HXMavlinkRCEncoder kept prebuilt frame
+static uint8_t buildLibraryFrame( bool mavlink_v1, const uint16_t* ch, uint8_t seq, uint8_t* buffer )
+{
+    mavlink_status_t* status = mavlink_get_channel_status( MAVLINK_COMM_0 );
+    status->flags = 0;
+    status->current_tx_seq = seq;
+
+    mavlink_message_t msg;
+    mavlink_msg_rc_channels_override_pack(
+            1, MAV_COMP_ID_USER1,
+            &msg,
+            1, MAV_COMP_ID_AUTOPILOT1,
+            ch[0], ch[1], ch[2], ch[3], ch[4], ch[5], ch[6], ch[7],
+            ch[8], ch[9], ch[10], ch[11], ch[12], ch[13], ch[14], ch[15],
+            0, 0
+        );
+
+    if ( mavlink_v1 )
+    {
+        status->flags = MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+        status->current_tx_seq = seq;
+        mavlink_finalize_message_chan(
+            &msg, 1, MAV_COMP_ID_USER1,
+            MAVLINK_COMM_0,
+            MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_MIN_LEN, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_LEN, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE_CRC );
+        status->flags = 0;
+    }
+
+    return mavlink_msg_to_send_buffer( buffer, &msg );
+}
+
+//=====================================================================
+//=====================================================================
+static bool checkIdentical( bool mavlink_v1 )
+{
+    std::mt19937 rng( 1 );
+    HXMavlinkRCEncoder encoder;
+    encoder.init( 20, mavlink_v1 );
+
+    uint16_t ch[MAVLINK_RC_CHANNELS_COUNT];
+    uint8_t expected[MAVLINK_MAX_PACKET_LEN];
+    uint8_t frame[MAVLINK_RC_FRAME_SIZE_MAX];
+
+    for ( uint32_t k = 0; k < CHECK_FRAMES_COUNT; k++ )
+    {
+        for ( uint8_t i = 0; i < MAVLINK_RC_CHANNELS_COUNT; i++ )
+        {
+            ch[i] = 1000 + rng() % 1001;
+            //v1 frame has 8 channels, higher are not sent
+            if ( mavlink_v1 && ( i >= MAVLINK_RC_CHANNELS_COUNT_V1 ) ) ch[i] = 1000;
+            encoder.setChannelValue( i, ch[i] );
+        }
+
+        uint8_t expectedLength = buildLibraryFrame( mavlink_v1, ch, (uint8_t)k, expected );
+        uint8_t length = encoder.getFrame( frame );
+
+        if ( ( length != expectedLength ) || ( memcmp( frame, expected, length ) != 0 ) )
+        {
+            printf( "FAIL: MAVLink %s frame %u differs from library frame (length %u, expected %u)\n", mavlink_v1 ? "v1" : "v2", k, length, expectedLength );
+            return false;
+        }
+    }
+
+    printf( "MAVLink %s: %u frames identical to library path\n", mavlink_v1 ? "v1" : "v2", CHECK_FRAMES_COUNT );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+//any 16 bit values: frame is parsed by library and channels are decoded back
+static bool checkDecodes( bool mavlink_v1 )
+{
+    std::mt19937 rng( 2 );
+    HXMavlinkRCEncoder encoder;
+    encoder.init( 20, mavlink_v1 );
+
+    uint8_t channelsCount = mavlink_v1 ? MAVLINK_RC_CHANNELS_COUNT_V1 : MAVLINK_RC_CHANNELS_COUNT;
+    uint16_t ch[MAVLINK_RC_CHANNELS_COUNT];
+    uint8_t frame[MAVLINK_RC_FRAME_SIZE_MAX];
+    mavlink_status_t status;
+    memset( &status, 0, sizeof( status ) );
+
+    for ( uint32_t k = 0; k < CHECK_FRAMES_COUNT; k++ )
+    {
+        for ( uint8_t i = 0; i < channelsCount; i++ )
+        {
+            ch[i] = ( rng() % 4 ) ? rng() % 65536 : rng() % 256;
+            encoder.setChannelValue( i, ch[i] );
+        }
+
+        uint8_t length = encoder.getFrame( frame );
+        mavlink_message_t msg;
+        uint8_t parsed = 0;
+        for ( uint8_t i = 0; i < length; i++ ) parsed += mavlink_parse_char( MAVLINK_COMM_1, frame[i], &msg, &status );
+
+        mavlink_rc_channels_override_t rc;
+        memset( &rc, 0, sizeof( rc ) );
+        if ( parsed == 1 ) mavlink_msg_rc_channels_override_decode( &msg, &rc );
+        const uint16_t decoded[MAVLINK_RC_CHANNELS_COUNT] =
+        {
+            rc.chan1_raw, rc.chan2_raw, rc.chan3_raw, rc.chan4_raw, rc.chan5_raw, rc.chan6_raw, rc.chan7_raw, rc.chan8_raw,
+            rc.chan9_raw, rc.chan10_raw, rc.chan11_raw, rc.chan12_raw, rc.chan13_raw, rc.chan14_raw, rc.chan15_raw, rc.chan16_raw
+        };
+
+        if ( ( parsed != 1 ) || ( msg.msgid != MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE ) || ( memcmp( decoded, ch, channelsCount * 2 ) != 0 ) )
+        {
+            printf( "FAIL: MAVLink %s frame %u with any 16 bit values is not decoded back\n", mavlink_v1 ? "v1" : "v2", k );
+            return false;
+        }
+    }
+
+    printf( "MAVLink %s: %u frames with any 16 bit values decoded by library\n", mavlink_v1 ? "v1" : "v2", CHECK_FRAMES_COUNT );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static void bench( bool mavlink_v1 )
+{
+    uint16_t ch[MAVLINK_RC_CHANNELS_COUNT];
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    volatile uint32_t sink = 0;
+    BenchTimer libraryTimer;
+    BenchTimer encoderTimer;
+
+    libraryTimer.start();
+    for ( uint32_t k = 0; k < BENCH_FRAMES_COUNT; k++ )
+    {
+        for ( uint8_t i = 0; i < MAVLINK_RC_CHANNELS_COUNT; i++ ) ch[i] = 1000 + ( ( k + i * 37 ) & 511 );
+        sink += buildLibraryFrame( mavlink_v1, ch, (uint8_t)k, buffer );
+    }
+    libraryTimer.stop();
+
+    HXMavlinkRCEncoder encoder;
+    encoder.init( 20, mavlink_v1 );
+
+    encoderTimer.start();
+    for ( uint32_t k = 0; k < BENCH_FRAMES_COUNT; k++ )
+    {
+        for ( uint8_t i = 0; i < MAVLINK_RC_CHANNELS_COUNT; i++ ) encoder.setChannelValue( i, 1000 + ( ( k + i * 37 ) & 511 ) );
+        sink += encoder.getFrame( buffer );
+    }
+    encoderTimer.stop();
+
+    printf( "MAVLink %s: library path %.1f ns/frame (%.0f cycles), encoder %.1f ns/frame (%.0f cycles)\n",
+        mavlink_v1 ? "v1" : "v2",
+        libraryTimer.ns / BENCH_FRAMES_COUNT, (double)libraryTimer.cycles / BENCH_FRAMES_COUNT,
+        encoderTimer.ns / BENCH_FRAMES_COUNT, (double)encoderTimer.cycles / BENCH_FRAMES_COUNT );
+}
+
+//=====================================================================
+//=====================================================================
+int main()
+{
+    bool ok = checkIdentical( true ) && checkIdentical( false ) && checkDecodes( true ) && checkDecodes( false );
+    if ( !ok ) return 1;
+
+    bench( true );
+    bench( false );
+    return 0;
+}
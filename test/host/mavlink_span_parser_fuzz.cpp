@@ -0,0 +1,474 @@
+//Fuzz regression test and benchmark for HXMavlinkSpanParser.
+//
+//Telemetry stream is corrupted (bit flips, stray STX bytes, garbage runs, cut frames) and fed through
+//ring buffers of random size in random chunks, so frames are split between two spans.
+//Every frame returned by parser must be accepted by mavlink_frame_char_buffer() on its own,
+//and view fields and getMessage() must match library decoding.
+//Every frame found by library parser in the same input must also be found by span parser.
+//
+//Mode which passes unknown messages: frames with message ids outside of dialect, mixed into clean stream,
+//must be passed byte to byte. On corrupted stream, known frames must still validate.
+//
+//Benchmark: bytes/sec of mavlink_parse_char() and span parser over the same stream.
+//
+//Usage: mavlink_span_parser_fuzz [recorded_stream.bin]
+//Returns 1 on failure.
+
+//parser validates against ardupilotmega dialect, reference must use the same table
+#define HX_MAVLINK_DIALECT_ARDUPILOTMEGA
+#include "hx_mavlink_common.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "hx_mavlink_span_parser.h"
+#include "telemetry_stream.h"
+#include "bench_timer.h"
+
+#define FUZZ_ROUNDS         200
+#define REPEAT_COUNT        10
+//not in common/ardupilotmega dialects
+#define UNKNOWN_MSG_ID      60123
+
+static std::mt19937 rng( 1 );
+
+//=====================================================================
+//=====================================================================
+typedef struct
+{
+    uint32_t msgId;
+    uint8_t seq;
+    uint16_t checksum;
+} FrameKey;
+
+//=====================================================================
+//=====================================================================
+static uint32_t randomInt( uint32_t n )
+{
+    return rng() % n;
+}
+
+//=====================================================================
+//=====================================================================
+static void corrupt( std::vector<uint8_t>& data )
+{
+    uint32_t events = data.size() / 200;
+    for ( uint32_t k = 0; k < events; k++ )
+    {
+        size_t at = randomInt( data.size() );
+        switch ( randomInt( 4 ) )
+        {
+            case 0:
+                data[at] ^= 1 << randomInt( 8 );
+                break;
+
+            case 1:
+                data.insert( data.begin() + at, randomInt( 2 ) ? MAVLINK_STX : MAVLINK_STX_MAVLINK1 );
+                break;
+
+            case 2:
+            {
+                uint8_t garbage[32];
+                uint8_t len = 1 + randomInt( sizeof( garbage ) );
+                for ( uint8_t i = 0; i < len; i++ ) garbage[i] = randomInt( 4 ) ? randomInt( 256 ) : MAVLINK_STX;
+                data.insert( data.begin() + at, garbage, garbage + len );
+                break;
+            }
+
+            default:
+            {
+                size_t len = 1 + randomInt( 40 );
+                if ( at + len > data.size() ) len = data.size() - at;
+                data.erase( data.begin() + at, data.begin() + at + len );
+                break;
+            }
+        }
+    }
+}
+
+//=====================================================================
+//=====================================================================
+//library parser. After BAD_CRC, library accepts frame whose incompat flags were corrupted to "signed"
+//when 13 more bytes arrive (CRC of signed frame is not checked against payload end): such frames are skipped.
+static std::vector<FrameKey> parseLibrary( const std::vector<uint8_t>& data )
+{
+    std::vector<FrameKey> frames;
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    memset( &status, 0, sizeof( status ) );
+
+    size_t lastBadCRC = 0;
+    for ( size_t i = 0; i < data.size(); i++ )
+    {
+        uint8_t res = mavlink_frame_char_buffer( &msg, &status, data[i], NULL, NULL );
+        if ( res == MAVLINK_FRAMING_BAD_CRC ) lastBadCRC = i + 1;
+        if ( res != MAVLINK_FRAMING_OK ) continue;
+        if ( ( msg.incompat_flags & MAVLINK_IFLAG_SIGNED ) && ( lastBadCRC + MAVLINK_SIGNATURE_BLOCK_LEN == i + 1 ) ) continue;
+
+        FrameKey key = { msg.msgid, msg.seq, msg.checksum };
+        frames.push_back( key );
+    }
+    return frames;
+}
+
+//=====================================================================
+//=====================================================================
+//frame alone must be accepted by library, view must match decoded message
+static bool validateFrame( const HXMavlinkFrameView& view )
+{
+    uint8_t buffer[HX_MAVLINK_SPAN_PARSER_FRAME_MAX];
+    uint16_t length = view.getLength();
+    view.copyTo( buffer );
+
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    memset( &status, 0, sizeof( status ) );
+
+    for ( uint16_t i = 0; i < length; i++ )
+    {
+        uint8_t res = mavlink_frame_char_buffer( &msg, &status, buffer[i], NULL, NULL );
+        if ( ( res == MAVLINK_FRAMING_OK ) != ( i == length - 1 ) )
+        {
+            printf( "FAIL: frame msgid %u length %u is not accepted by mavlink_frame_char_buffer() (result %u at byte %u)\n", view.msgId, length, res, i );
+            return false;
+        }
+    }
+
+    if ( ( msg.msgid != view.msgId ) || ( msg.sysid != view.sysId ) || ( msg.compid != view.compId ) ||
+        ( msg.len != view.payloadLength ) || ( ( msg.magic == MAVLINK_STX_MAVLINK1 ) != view.mavlink1 ) )
+    {
+        printf( "FAIL: view fields of msgid %u differ from library\n", view.msgId );
+        return false;
+    }
+
+    mavlink_message_t viewMsg;
+    view.getMessage( &viewMsg );
+    if ( ( viewMsg.checksum != msg.checksum ) || ( viewMsg.seq != msg.seq ) ||
+        ( memcmp( _MAV_PAYLOAD( &viewMsg ), _MAV_PAYLOAD( &msg ), msg.len ) != 0 ) )
+    {
+        printf( "FAIL: getMessage() of msgid %u differs from library\n", view.msgId );
+        return false;
+    }
+
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+//feed data through ring buffer in chunks, parse both spans. Returns false on validation failure.
+//Known frames are validated, all returned frames are appended to output if it is not NULL.
+static bool parseSpans( const std::vector<uint8_t>& data, uint16_t ringSize, uint16_t chunkMax, bool validate, bool passUnknown,
+    std::vector<FrameKey>& frames, std::vector<uint8_t>* output )
+{
+    std::vector<uint8_t> ring( ringSize );
+    uint16_t head = 0;
+    uint16_t count = 0;
+    size_t pos = 0;
+
+    HXMavlinkSpanParser parser;
+    HXMavlinkFrameView view;
+    parser.setPassUnknownMessages( passUnknown );
+
+    while ( true )
+    {
+        size_t n = validate ? 1 + randomInt( chunkMax ) : chunkMax;
+        if ( n > data.size() - pos ) n = data.size() - pos;
+        if ( n > (size_t)( ringSize - count ) ) n = ringSize - count;
+        for ( size_t i = 0; i < n; i++ ) ring[( head + count + i ) % ringSize] = data[pos + i];
+        pos += n;
+        count += n;
+
+        uint16_t length1 = ringSize - head;
+        if ( length1 > count ) length1 = count;
+        parser.setInput( &ring[head], length1, &ring[0], count - length1 );
+
+        while ( parser.next( &view ) )
+        {
+            if ( validate && view.known && !validateFrame( view ) ) return false;
+            if ( !view.known && !passUnknown )
+            {
+                printf( "FAIL: unknown msgid %u returned\n", view.msgId );
+                return false;
+            }
+
+            if ( output != NULL )
+            {
+                uint8_t buffer[HX_MAVLINK_SPAN_PARSER_FRAME_MAX];
+                view.copyTo( buffer );
+                output->insert( output->end(), buffer, buffer + view.getLength() );
+            }
+
+            mavlink_message_t msg;
+            view.getMessage( &msg );
+            FrameKey key = { msg.msgid, msg.seq, msg.checksum };
+            frames.push_back( key );
+        }
+
+        uint16_t consumed = parser.getConsumed();
+        if ( consumed > count )
+        {
+            printf( "FAIL: parser consumed %u of %u bytes\n", consumed, count );
+            return false;
+        }
+        head = ( head + consumed ) % ringSize;
+        count -= consumed;
+
+        if ( pos == data.size() )
+        {
+            //only incomplete frame may be left
+            if ( count >= HX_MAVLINK_SPAN_PARSER_FRAME_MAX )
+            {
+                printf( "FAIL: %u bytes left unparsed\n", count );
+                return false;
+            }
+            return true;
+        }
+    }
+}
+
+//=====================================================================
+//=====================================================================
+//returns number of frames of reference which are present in frames, in the same order.
+//Span parser may find more: it resyncs from STX+1 where library skips to the end of bad frame.
+static size_t countFound( const std::vector<FrameKey>& frames, const std::vector<FrameKey>& reference, bool report )
+{
+    size_t found = 0;
+    size_t j = 0;
+    for ( size_t i = 0; i < reference.size(); i++ )
+    {
+        size_t k = j;
+        while ( ( k < frames.size() ) &&
+            !( ( frames[k].msgId == reference[i].msgId ) && ( frames[k].seq == reference[i].seq ) && ( frames[k].checksum == reference[i].checksum ) ) ) k++;
+        if ( k == frames.size() )
+        {
+            if ( report ) printf( "FAIL: frame %zu (msgid %u) found by library is missed by span parser\n", i, reference[i].msgId );
+            continue;
+        }
+        j = k + 1;
+        found++;
+    }
+    return found;
+}
+
+//=====================================================================
+//=====================================================================
+static bool fuzz( const std::vector<uint8_t>& stream )
+{
+    uint32_t framesTotal = 0;
+    uint32_t extraTotal = 0;
+    uint32_t passUnknownLost = 0;
+    uint32_t passUnknownTotal = 0;
+
+    for ( uint32_t round = 0; round < FUZZ_ROUNDS; round++ )
+    {
+        //clean stream starts with frame, otherwise library may lose frame after the first partial one
+        bool clean = ( round % 10 ) == 0;
+        size_t start = clean ? 0 : randomInt( stream.size() / 2 );
+        std::vector<uint8_t> data( stream.begin() + start, stream.begin() + start + stream.size() / 20 );
+        if ( !clean ) corrupt( data );
+        //stray STX near the end may announce frame longer than the rest of input: parser waits for more data.
+        //Trailing zeros (no STX) complete such candidates, so frames after them are parsed too
+        data.insert( data.end(), HX_MAVLINK_SPAN_PARSER_FRAME_MAX, 0 );
+
+        uint16_t ringSize = HX_MAVLINK_SPAN_PARSER_FRAME_MAX + randomInt( 800 );
+        uint16_t chunkMax = 1 + randomInt( 300 );
+
+        std::vector<FrameKey> reference = parseLibrary( data );
+
+        //in this mode stray STX may be taken as start of unknown frame which swallows valid frames
+        if ( !clean && ( ( round % 10 ) == 5 ) )
+        {
+            std::vector<FrameKey> frames;
+            if ( !parseSpans( data, ringSize, chunkMax, true, true, frames, NULL ) ) return false;
+            passUnknownLost += reference.size() - countFound( frames, reference, false );
+            passUnknownTotal += reference.size();
+        }
+
+        std::vector<FrameKey> frames;
+        if ( !parseSpans( data, ringSize, chunkMax, true, false, frames, NULL ) ) return false;
+
+        if ( countFound( frames, reference, true ) != reference.size() ) return false;
+        if ( clean && ( frames.size() != reference.size() ) )
+        {
+            printf( "FAIL: clean stream: span parser %zu frames, library %zu\n", frames.size(), reference.size() );
+            return false;
+        }
+
+        framesTotal += frames.size();
+        extraTotal += frames.size() - reference.size();
+    }
+
+    printf( "fuzz: %u rounds, %u frames validated, %u frames recovered by resync which library lost\n", FUZZ_ROUNDS, framesTotal, extraTotal );
+    printf( "fuzz, unknown messages passed: %u of %u frames lost\n", passUnknownLost, passUnknownTotal );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+//frame with message id outside of dialect, CRC is random
+static void appendUnknownFrame( std::vector<uint8_t>& data, bool mavlink1, uint32_t msgId )
+{
+    uint8_t payloadLength = randomInt( 256 );
+    data.push_back( mavlink1 ? MAVLINK_STX_MAVLINK1 : MAVLINK_STX );
+    data.push_back( payloadLength );
+    if ( !mavlink1 )
+    {
+        data.push_back( 0 );
+        data.push_back( 0 );
+    }
+    data.push_back( randomInt( 256 ) );
+    data.push_back( 1 );
+    data.push_back( MAV_COMP_ID_USER1 );
+    data.push_back( msgId & 0xff );
+    if ( !mavlink1 )
+    {
+        data.push_back( ( msgId >> 8 ) & 0xff );
+        data.push_back( msgId >> 16 );
+    }
+    for ( uint16_t i = 0; i < payloadLength + MAVLINK_NUM_CHECKSUM_BYTES; i++ ) data.push_back( randomInt( 256 ) );
+}
+
+//=====================================================================
+//=====================================================================
+static bool checkPassUnknown( const std::vector<uint8_t>& stream )
+{
+    uint32_t unknownMsgIdV1 = 0;
+    while ( mavlink_get_msg_entry( unknownMsgIdV1 ) != NULL ) unknownMsgIdV1++;
+    if ( ( mavlink_get_msg_entry( UNKNOWN_MSG_ID ) != NULL ) || ( unknownMsgIdV1 > 255 ) )
+    {
+        printf( "FAIL: no unknown message ids in dialect\n" );
+        return false;
+    }
+
+    //unknown frames between known frames
+    std::vector<uint8_t> data;
+    std::vector<FrameKey> reference = parseLibrary( std::vector<uint8_t>( stream.begin(), stream.begin() + stream.size() / 20 ) );
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    memset( &status, 0, sizeof( status ) );
+    uint32_t unknownCount = 0;
+    size_t frameEnd = 0;
+    for ( size_t i = 0; i < stream.size() / 20; i++ )
+    {
+        data.push_back( stream[i] );
+        if ( !mavlink_parse_char( MAVLINK_COMM_3, stream[i], &msg, &status ) ) continue;
+
+        if ( randomInt( 4 ) == 0 )
+        {
+            bool mavlink1 = randomInt( 2 ) == 0;
+            appendUnknownFrame( data, mavlink1, mavlink1 ? unknownMsgIdV1 : UNKNOWN_MSG_ID );
+            unknownCount++;
+        }
+        frameEnd = data.size();
+    }
+    //no incomplete frame at the end
+    data.resize( frameEnd );
+
+    for ( int r = 0; r < 20; r++ )
+    {
+        uint16_t ringSize = HX_MAVLINK_SPAN_PARSER_FRAME_MAX + randomInt( 800 );
+        uint16_t chunkMax = 1 + randomInt( 300 );
+
+        std::vector<FrameKey> frames;
+        std::vector<uint8_t> output;
+        if ( !parseSpans( data, ringSize, chunkMax, true, true, frames, &output ) ) return false;
+        if ( output != data )
+        {
+            printf( "FAIL: unknown messages passed: output %zu bytes differs from input %zu bytes\n", output.size(), data.size() );
+            return false;
+        }
+
+        frames.clear();
+        if ( !parseSpans( data, ringSize, chunkMax, true, false, frames, NULL ) ) return false;
+        if ( countFound( frames, reference, true ) != reference.size() ) return false;
+        if ( frames.size() != reference.size() )
+        {
+            printf( "FAIL: unknown messages dropped: %zu frames, expected %zu\n", frames.size(), reference.size() );
+            return false;
+        }
+    }
+
+    printf( "unknown messages: %u frames mixed into %zu bytes passed byte to byte, dropped in strict mode\n", unknownCount, data.size() );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static void bench( const std::vector<uint8_t>& stream )
+{
+    double best[3] = { 1e30, 1e30, 1e30 };
+    size_t frames[3] = { 0, 0, 0 };
+
+    for ( int r = 0; r < REPEAT_COUNT; r++ )
+    {
+        BenchTimer timer;
+
+        timer.start();
+        mavlink_message_t msg;
+        mavlink_status_t status;
+        memset( &status, 0, sizeof( status ) );
+        frames[0] = 0;
+        for ( size_t i = 0; i < stream.size(); i++ )
+        {
+            if ( mavlink_parse_char( MAVLINK_COMM_2, stream[i], &msg, &status ) ) frames[0]++;
+        }
+        timer.stop();
+        if ( timer.ns < best[0] ) best[0] = timer.ns;
+
+        //as in HXRCMavlinkFrameQueue: 512 byte ring, serial data arrives in 64 byte chunks, includes copy into ring
+        std::vector<FrameKey> keys;
+        keys.reserve( frames[0] );
+        timer.start();
+        parseSpans( stream, 512, 64, false, false, keys, NULL );
+        timer.stop();
+        frames[1] = keys.size();
+        if ( timer.ns < best[1] ) best[1] = timer.ns;
+
+        timer.start();
+        HXMavlinkSpanParser parser;
+        HXMavlinkFrameView view;
+        frames[2] = 0;
+        for ( size_t pos = 0; pos < stream.size(); )
+        {
+            size_t n = stream.size() - pos;
+            if ( n > 60000 ) n = 60000;
+            parser.setInput( &stream[pos], n );
+            while ( parser.next( &view ) ) frames[2]++;
+            pos += parser.getConsumed();
+            if ( n < 60000 ) break;
+        }
+        timer.stop();
+        if ( timer.ns < best[2] ) best[2] = timer.ns;
+    }
+
+    printf( "%zu bytes, %zu frames:\n", stream.size(), frames[0] );
+    printf( "  mavlink_parse_char():                  %.1f MB/s\n", stream.size() / best[0] * 1e3 );
+    printf( "  span parser, 512B ring, 64B chunks:    %.1f MB/s (%zu frames, includes message decode)\n", stream.size() / best[1] * 1e3, frames[1] );
+    printf( "  span parser, contiguous buffer:        %.1f MB/s (%zu frames)\n", stream.size() / best[2] * 1e3, frames[2] );
+}
+
+//=====================================================================
+//=====================================================================
+int main( int argc, char** argv )
+{
+    std::vector<uint8_t> stream;
+    if ( argc > 1 )
+    {
+        if ( !loadTelemetryStream( argv[1], stream ) )
+        {
+            printf( "Can not read %s\n", argv[1] );
+            return 1;
+        }
+    }
+    else
+    {
+        generateTelemetryStream( 600, stream );
+    }
+
+    if ( !fuzz( stream ) || !checkPassUnknown( stream ) ) return 1;
+
+    bench( stream );
+    return 0;
+}
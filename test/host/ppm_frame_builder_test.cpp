@@ -0,0 +1,157 @@
+//HXPPMFrameBuilder: for 4, 8 and 16 channels, with values inside and outside of 1000...2000:
+//- one item per channel plus sync item;
+//- every item starts with HXPPM_PULSE_LENGTH_US pulse;
+//- channel item width (pulse start to next pulse start) is the value constrained to 1000...2000;
+//- sync pause is not shorter than HXPPM_PAUSE_LENGTH_US;
+//- frame length is constant and equal to getFrameLengthUs().
+//
+//Returns 1 on failure.
+
+#include <stdio.h>
+#include <random>
+
+#include "hx_ppm_frame_builder.h"
+
+#define RANDOM_FRAMES_COUNT     100000
+
+static std::mt19937 rng( 1 );
+
+//=====================================================================
+//=====================================================================
+static uint16_t constrainValue( uint16_t v )
+{
+    if ( v < 1000 ) return 1000;
+    if ( v > 2000 ) return 2000;
+    return v;
+}
+
+//=====================================================================
+//=====================================================================
+static bool checkFrame( const HXPPMFrameBuilder& builder, const uint16_t* values )
+{
+    uint8_t channelsCount = builder.getChannelsCount();
+    uint32_t expectedLengthUs = (uint32_t)channelsCount * 2000 + HXPPM_PAUSE_LENGTH_US + HXPPM_PULSE_LENGTH_US;
+
+    if ( builder.getFrameLengthUs() != expectedLengthUs )
+    {
+        printf( "FAIL: %u channels: frame length %u, expected %u\n", channelsCount, builder.getFrameLengthUs(), expectedLengthUs );
+        return false;
+    }
+
+    HXPPMItem items[HXPPM_MAX_ITEMS_COUNT];
+    uint8_t count = builder.build( values, items );
+    if ( count != channelsCount + 1 )
+    {
+        printf( "FAIL: %u channels: %u items\n", channelsCount, count );
+        return false;
+    }
+
+    uint32_t lengthUs = 0;
+    for ( uint8_t i = 0; i < count; i++ )
+    {
+        if ( items[i].highUs != HXPPM_PULSE_LENGTH_US )
+        {
+            printf( "FAIL: %u channels: item %u pulse %u us\n", channelsCount, i, items[i].highUs );
+            return false;
+        }
+
+        uint32_t widthUs = items[i].highUs + items[i].lowUs;
+        if ( ( i < channelsCount ) && ( widthUs != constrainValue( values[i] ) ) )
+        {
+            printf( "FAIL: %u channels: channel %u value %u, item width %u us\n", channelsCount, i, values[i], widthUs );
+            return false;
+        }
+        lengthUs += widthUs;
+    }
+
+    if ( items[channelsCount].lowUs < HXPPM_PAUSE_LENGTH_US )
+    {
+        printf( "FAIL: %u channels: sync pause %u us\n", channelsCount, items[channelsCount].lowUs );
+        return false;
+    }
+
+    if ( lengthUs != expectedLengthUs )
+    {
+        printf( "FAIL: %u channels: frame is %u us, expected %u\n", channelsCount, lengthUs, expectedLengthUs );
+        return false;
+    }
+
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static bool checkChannelsCount( uint8_t channelsCount )
+{
+    HXPPMFrameBuilder builder;
+    builder.init( channelsCount );
+    if ( builder.getChannelsCount() != channelsCount )
+    {
+        printf( "FAIL: init( %u ) gives %u channels\n", channelsCount, builder.getChannelsCount() );
+        return false;
+    }
+
+    uint16_t values[HXPPM_MAX_CHANNELS_COUNT];
+
+    //edge values, all channels equal
+    const uint16_t edges[] = { 0, 999, 1000, 1001, 1500, 1999, 2000, 2001, 2500, 65535 };
+    for ( uint8_t e = 0; e < sizeof( edges ) / sizeof( edges[0] ); e++ )
+    {
+        for ( uint8_t i = 0; i < channelsCount; i++ ) values[i] = edges[e];
+        if ( !checkFrame( builder, values ) ) return false;
+    }
+
+    //mixed values, some out of range
+    for ( uint32_t k = 0; k < RANDOM_FRAMES_COUNT; k++ )
+    {
+        for ( uint8_t i = 0; i < channelsCount; i++ )
+        {
+            switch ( rng() % 4 )
+            {
+                case 0: values[i] = rng() % 1000; break;
+                case 1: values[i] = 2001 + rng() % 63535; break;
+                default: values[i] = 1000 + rng() % 1001; break;
+            }
+        }
+        if ( !checkFrame( builder, values ) ) return false;
+    }
+
+    printf( "%2u channels: frame %u us, %u frames checked\n", channelsCount, builder.getFrameLengthUs(), RANDOM_FRAMES_COUNT );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static bool checkInitConstrained()
+{
+    HXPPMFrameBuilder builder;
+    if ( builder.getChannelsCount() != 8 )
+    {
+        printf( "FAIL: default channels count %u\n", builder.getChannelsCount() );
+        return false;
+    }
+
+    builder.init( 0 );
+    if ( builder.getChannelsCount() != 4 )
+    {
+        printf( "FAIL: init( 0 ) gives %u channels\n", builder.getChannelsCount() );
+        return false;
+    }
+
+    builder.init( HXPPM_MAX_CHANNELS_COUNT + 1 );
+    if ( builder.getChannelsCount() != HXPPM_MAX_CHANNELS_COUNT )
+    {
+        printf( "FAIL: init( %u ) gives %u channels\n", HXPPM_MAX_CHANNELS_COUNT + 1, builder.getChannelsCount() );
+        return false;
+    }
+
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+int main()
+{
+    bool ok = checkInitConstrained() && checkChannelsCount( 4 ) && checkChannelsCount( 8 ) && checkChannelsCount( 16 );
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+//Fuzz driver and throughput benchmark for HXSBUSFrameParser.
+//
+//Gapped stream (SBUS timing, frame every 7 or 14ms): frames are pushed in random chunks with random UART polls,
+//noise bursts with 0x0F/0x00 bytes are injected between frames and some frames are corrupted.
+//Every frame which starts after inter-frame gap and is not corrupted must be published exactly once,
+//in the push which contains its last byte.
+//
+//Back-to-back stream (no gaps, f.e. replay from buffer): starts with noise. After parser is synced,
+//every frame must be published exactly once.
+//
+//Returns 1 on failure.
+
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "hx_sbus_frame_parser.h"
+#include "bench_timer.h"
+
+//100000 baud 8E2
+#define BYTE_TIME_US            120
+#define FRAMES_COUNT            200000
+
+static std::mt19937 rng( 1 );
+
+//=====================================================================
+//=====================================================================
+static uint32_t randomInt( uint32_t n )
+{
+    return rng() % n;
+}
+
+//=====================================================================
+//=====================================================================
+//header, random channels and flags, SBUS or SBUS2 footer
+static void makeFrame( uint8_t* frame )
+{
+    frame[0] = HXSBUS_FRAME_HEADER;
+    for ( int i = 1; i < HXSBUS_FRAME_SIZE - 1; i++ ) frame[i] = randomInt( 256 );
+    frame[HXSBUS_FRAME_SIZE - 2] &= 0x0f;
+    frame[HXSBUS_FRAME_SIZE - 1] = randomInt( 3 ) ? HXSBUS_FRAME_FOOTER : ( HXSBUS2_FOOTER | ( randomInt( 4 ) << 4 ) );
+}
+
+//=====================================================================
+//=====================================================================
+//noise on the line: mostly header and footer bytes
+static uint8_t noiseByte()
+{
+    switch ( randomInt( 3 ) )
+    {
+        case 0: return HXSBUS_FRAME_HEADER;
+        case 1: return HXSBUS_FRAME_FOOTER;
+        default: return randomInt( 256 );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+class Driver
+{
+public:
+    HXSBUSFrameParser parser;
+    unsigned long timeUs;
+    unsigned long lastPushTimeUs;
+    uint32_t lastCounter;
+    uint32_t published;
+    bool failed;
+
+    Driver() : timeUs( 0 ), lastPushTimeUs( 0 ), lastCounter( 0 ), published( 0 ), failed( false ) {}
+
+    void poll()
+    {
+        this->parser.push( NULL, 0, this->timeUs );
+    }
+
+    void silence( unsigned long us )
+    {
+        unsigned long end = this->timeUs + us;
+        while ( this->timeUs < end )
+        {
+            this->timeUs += 1 + randomInt( 1500 );
+            if ( this->timeUs > end ) this->timeUs = end;
+            poll();
+        }
+    }
+
+    //returns number of frames published by this push
+    uint32_t push( const uint8_t* data, uint16_t len )
+    {
+        this->timeUs += len * BYTE_TIME_US;
+        this->parser.push( data, len, this->timeUs );
+        this->lastPushTimeUs = this->timeUs;
+
+        uint32_t counter = this->parser.getFrameCounter();
+        uint32_t n = counter - this->lastCounter;
+        this->lastCounter = counter;
+        this->published += n;
+
+        if ( n > 1 )
+        {
+            printf( "FAIL: %u frames published by one push\n", n );
+            this->failed = true;
+        }
+        return n;
+    }
+
+    //random chunks, sometimes UART is polled empty inside frame (shorter than gap).
+    //Returns number of frames published by push of the last byte.
+    uint32_t pushChunked( const uint8_t* data, uint16_t len, bool expectNoneBefore )
+    {
+        uint16_t pos = 0;
+        uint32_t n = 0;
+        while ( pos < len )
+        {
+            uint16_t chunk = 1 + randomInt( HXSBUS_FRAME_SIZE );
+            if ( chunk > len - pos ) chunk = len - pos;
+            n = push( data + pos, chunk );
+            pos += chunk;
+
+            if ( ( pos < len ) && ( n > 0 ) && expectNoneBefore )
+            {
+                printf( "FAIL: frame published before its last byte\n" );
+                this->failed = true;
+            }
+            if ( randomInt( 4 ) == 0 )
+            {
+                this->timeUs += randomInt( HXSBUS_MIN_GAP_US / 2 );
+                poll();
+            }
+        }
+        return n;
+    }
+
+    void expectPublished( uint32_t n, const uint8_t* frame, const char* name, uint32_t index )
+    {
+        if ( n != 1 )
+        {
+            printf( "FAIL: %s frame %u published %u times\n", name, index, n );
+            this->failed = true;
+        }
+        else if ( memcmp( this->parser.getFrame(), frame, HXSBUS_FRAME_SIZE ) != 0 )
+        {
+            printf( "FAIL: %s frame %u content mismatch\n", name, index );
+            this->failed = true;
+        }
+        else if ( this->parser.getFrameTimeUs() != this->lastPushTimeUs )
+        {
+            printf( "FAIL: %s frame %u time mismatch\n", name, index );
+            this->failed = true;
+        }
+    }
+};
+
+//=====================================================================
+//=====================================================================
+static bool fuzzGapped()
+{
+    Driver d;
+    uint8_t frame[HXSBUS_FRAME_SIZE];
+    uint8_t noise[HXSBUS_FRAME_SIZE - 1];
+    uint32_t clean = 0;
+    uint32_t corrupted = 0;
+    uint32_t noiseBursts = 0;
+
+    for ( uint32_t k = 0; ( k < FRAMES_COUNT ) && !d.failed; k++ )
+    {
+        makeFrame( frame );
+
+        //inter-frame gap: frame every 7 or 14ms
+        d.silence( ( randomInt( 2 ) ? 4000 : 11000 ) + randomInt( 1000 ) );
+
+        //noise burst, shorter than frame so it can not look like a frame itself
+        bool noiseBeforeFrame = false;
+        if ( randomInt( 8 ) == 0 )
+        {
+            uint16_t len = 1 + randomInt( sizeof( noise ) );
+            for ( uint16_t i = 0; i < len; i++ ) noise[i] = noiseByte();
+            d.pushChunked( noise, len, false );
+            noiseBursts++;
+
+            //noise right before frame start, without silence
+            noiseBeforeFrame = randomInt( 4 ) == 0;
+            if ( !noiseBeforeFrame ) d.silence( HXSBUS_MIN_GAP_US + randomInt( 3000 ) );
+        }
+
+        bool corrupt = randomInt( 16 ) == 0;
+        if ( corrupt )
+        {
+            //wrong footer, inserted or lost byte
+            switch ( randomInt( 3 ) )
+            {
+                case 0: frame[HXSBUS_FRAME_SIZE - 1] = 0xff; break;
+                case 1: frame[1 + randomInt( HXSBUS_FRAME_SIZE - 2 )] = noiseByte(); frame[HXSBUS_FRAME_SIZE - 1] = 0xff; break;
+                default: memmove( frame + 1, frame + 2, HXSBUS_FRAME_SIZE - 2 ); frame[HXSBUS_FRAME_SIZE - 1] = 0xff; break;
+            }
+        }
+
+        uint32_t n = d.pushChunked( frame, HXSBUS_FRAME_SIZE, !noiseBeforeFrame );
+
+        if ( corrupt || noiseBeforeFrame )
+        {
+            corrupted++;
+            continue;
+        }
+
+        d.expectPublished( n, frame, "gapped", k );
+        clean++;
+    }
+
+    printf( "gapped: %u clean frames published, %u corrupted, %u noise bursts; parser: total %u invalid %u skipped %u gap resyncs %u\n",
+        clean, corrupted, noiseBursts, d.parser.framesTotal, d.parser.framesInvalid, d.parser.bytesSkipped, d.parser.gapResyncs );
+    return !d.failed;
+}
+
+//=====================================================================
+//=====================================================================
+static bool fuzzBackToBack( uint32_t seed )
+{
+    rng.seed( seed );
+
+    Driver d;
+    uint8_t frame[HXSBUS_FRAME_SIZE];
+    uint8_t noise[64];
+
+    uint16_t len = randomInt( sizeof( noise ) );
+    for ( uint16_t i = 0; i < len; i++ ) noise[i] = noiseByte();
+    d.pushChunked( noise, len, false );
+
+    int32_t syncedAt = -1;
+    for ( uint32_t k = 0; ( k < FRAMES_COUNT / 100 ) && !d.failed; k++ )
+    {
+        bool wasSynced = d.parser.isSynced();
+        makeFrame( frame );
+        uint32_t n = d.pushChunked( frame, HXSBUS_FRAME_SIZE, wasSynced );
+
+        if ( wasSynced )
+        {
+            d.expectPublished( n, frame, "back-to-back", k );
+        }
+        else if ( d.parser.isSynced() )
+        {
+            syncedAt = k;
+        }
+    }
+
+    if ( syncedAt < 0 )
+    {
+        printf( "FAIL: back-to-back stream (seed %u): parser did not sync\n", seed );
+        return false;
+    }
+    return !d.failed;
+}
+
+//=====================================================================
+//=====================================================================
+static void benchmark()
+{
+    const uint32_t framesCount = 4000;
+    std::vector<uint8_t> stream( framesCount * HXSBUS_FRAME_SIZE );
+    for ( uint32_t k = 0; k < framesCount; k++ ) makeFrame( &stream[k * HXSBUS_FRAME_SIZE] );
+
+    const uint16_t chunks[] = { 1, 25, 64 };
+    for ( uint8_t c = 0; c < sizeof( chunks ) / sizeof( chunks[0] ); c++ )
+    {
+        HXSBUSFrameParser parser;
+        BenchTimer timer;
+        const int repeat = 50;
+
+        timer.start();
+        for ( int r = 0; r < repeat; r++ )
+        {
+            for ( size_t pos = 0; pos < stream.size(); pos += chunks[c] )
+            {
+                size_t n = stream.size() - pos;
+                if ( n > chunks[c] ) n = chunks[c];
+                parser.push( &stream[pos], n, 1 );
+            }
+        }
+        timer.stop();
+
+        double bytes = (double)repeat * stream.size();
+        printf( "throughput, %2u byte chunks: %.1f MB/s, %.1f ns/frame, %.2f cycles/byte (%u frames)\n",
+            chunks[c], bytes / timer.ns * 1e3, timer.ns / ( repeat * framesCount ), timer.cycles / bytes, parser.framesTotal );
+    }
+}
+
+//=====================================================================
+//=====================================================================
+int main()
+{
+    bool ok = fuzzGapped();
+
+    uint32_t seeds = 0;
+    for ( uint32_t seed = 1; ( seed <= 100 ) && ok; seed++, seeds++ ) ok = fuzzBackToBack( seed );
+    if ( ok ) printf( "back-to-back: %u streams, all frames after sync published once\n", seeds );
+
+    benchmark();
+
+    return ok ? 0 : 1;
+}
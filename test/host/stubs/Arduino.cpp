@@ -0,0 +1,33 @@
+#include <Arduino.h>
+
+#include <chrono>
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+//=====================================================================
+//=====================================================================
+unsigned long millis()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - startTime ).count();
+}
+
+//=====================================================================
+//=====================================================================
+unsigned long micros()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - startTime ).count();
+}
+
+//=====================================================================
+//=====================================================================
+int HardwareSerial::availableForWrite()
+{
+    return 256;
+}
+
+//=====================================================================
+//=====================================================================
+size_t HardwareSerial::write( const uint8_t* buffer, size_t size )
+{
+    return size;
+}
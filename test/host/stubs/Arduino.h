@@ -0,0 +1,22 @@
+#pragma once
+
+//Minimal Arduino API for host builds of library code, see test/host/Makefile.
+//Only what platform independent parts of the libraries use.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+unsigned long millis();
+unsigned long micros();
+
+//=====================================================================
+//=====================================================================
+//discards data
+class HardwareSerial
+{
+public:
+    int availableForWrite();
+    size_t write( const uint8_t* buffer, size_t size );
+};
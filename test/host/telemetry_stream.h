@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#include "hx_mavlink_common.h"
+
+//Byte streams for host tests and benchmarks.
+//Recorded stream (raw capture of flight controller telemetry port) can be given as file,
+//otherwise stream with the same message mix is generated.
+
+//=====================================================================
+//=====================================================================
+//returns false if file can not be read
+static bool loadTelemetryStream( const char* fileName, std::vector<uint8_t>& stream )
+{
+    FILE* f = fopen( fileName, "rb" );
+    if ( f == NULL ) return false;
+
+    uint8_t buffer[4096];
+    size_t n;
+    while ( ( n = fread( buffer, 1, sizeof( buffer ), f ) ) > 0 ) stream.insert( stream.end(), buffer, buffer + n );
+    fclose( f );
+    return true;
+}
+
+//=====================================================================
+//=====================================================================
+static void appendMessage( std::vector<uint8_t>& stream, const mavlink_message_t* msg )
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    uint16_t len = mavlink_msg_to_send_buffer( buffer, msg );
+    stream.insert( stream.end(), buffer, buffer + len );
+}
+
+//=====================================================================
+//=====================================================================
+//Ardupilot plane with default SRx_ stream rates, 10 ticks per second.
+//Values change slowly like in flight, so compression ratio is close to real one.
+static void generateTelemetryStream( uint32_t seconds, std::vector<uint8_t>& stream )
+{
+    mavlink_message_t msg;
+    const uint8_t sysId = 1;
+    const uint8_t compId = MAV_COMP_ID_AUTOPILOT1;
+
+    for ( uint32_t tick = 0; tick < seconds * 10; tick++ )
+    {
+        uint32_t timeMs = tick * 100;
+        float t = timeMs / 1000.0f;
+
+        float roll = 0.3f * sinf( t * 0.5f );
+        float pitch = 0.1f * sinf( t * 0.3f );
+        float yaw = fmodf( t * 0.05f, 6.28f );
+        int32_t lat = 473977418 + (int32_t)( 2000 * sinf( t * 0.01f ) );
+        int32_t lon = 85455939 + (int32_t)( 2000 * cosf( t * 0.01f ) );
+        int32_t alt = 100000 + (int32_t)( 5000 * sinf( t * 0.02f ) );
+
+        mavlink_msg_attitude_pack( sysId, compId, &msg, timeMs, roll, pitch, yaw, 0.01f, -0.02f, 0.005f );
+        appendMessage( stream, &msg );
+
+        if ( ( tick % 2 ) == 0 )
+        {
+            mavlink_msg_global_position_int_pack( sysId, compId, &msg, timeMs, lat, lon, alt, alt - 90000, 1500, -300, 20, (uint16_t)( yaw * 5729 ) );
+            appendMessage( stream, &msg );
+
+            mavlink_msg_vfr_hud_pack( sysId, compId, &msg, 18.5f, 17.9f, (int16_t)( yaw * 57.3f ), 55, alt / 1000.0f, 0.2f );
+            appendMessage( stream, &msg );
+        }
+
+        if ( ( tick % 5 ) == 0 )
+        {
+            mavlink_msg_sys_status_pack( sysId, compId, &msg, 0x1020ffff, 0x1020ffff, 0x1020ffff, 230, 12150 - tick / 10, 1520, 80 - tick / 600, 0, 0, 0, 0, 0, 0 );
+            appendMessage( stream, &msg );
+
+            mavlink_msg_gps_raw_int_pack( sysId, compId, &msg, (uint64_t)timeMs * 1000, 3, lat, lon, alt, 90, 120, 1800, (uint16_t)( yaw * 5729 ), 14, 0, 0, 0, 0, 0 );
+            appendMessage( stream, &msg );
+
+            mavlink_msg_rc_channels_pack( sysId, compId, &msg, timeMs, 16,
+                1500 + (uint16_t)( 200 * roll ), 1500 + (uint16_t)( 200 * pitch ), 1400, 1500, 1000, 1000, 2000, 1500,
+                1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500, UINT16_MAX, UINT16_MAX, 255 );
+            appendMessage( stream, &msg );
+        }
+
+        if ( ( tick % 10 ) == 0 )
+        {
+            mavlink_msg_heartbeat_pack( sysId, compId, &msg, MAV_TYPE_FIXED_WING, MAV_AUTOPILOT_ARDUPILOTMEGA, 0x81, 10, MAV_STATE_ACTIVE );
+            appendMessage( stream, &msg );
+
+            mavlink_msg_system_time_pack( sysId, compId, &msg, 1600000000000000ull + (uint64_t)timeMs * 1000, timeMs );
+            appendMessage( stream, &msg );
+        }
+
+        if ( ( tick % 100 ) == 50 )
+        {
+            //pack() reads whole field
+            char text[MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN] = "EKF3 IMU0 is using GPS";
+            mavlink_msg_statustext_pack( sysId, compId, &msg, MAV_SEVERITY_INFO, text );
+            appendMessage( stream, &msg );
+        }
+    }
+}